@@ -0,0 +1,102 @@
+#include "asset_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include <raylib.h>
+
+namespace {
+
+uint64_t HashKey(const std::string& key) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+std::string EntryPath(const AssetCache& cache, const char* name, uint64_t hash) {
+    char file[96];
+    snprintf(file, sizeof(file), "%s-%016llx.bin", name, (unsigned long long)hash);
+    return (std::filesystem::path(cache.dir) / file).string();
+}
+
+size_t LayerSize(const AssetDesc& desc) {
+    return (size_t)GetPixelDataSize(desc.width, desc.height, desc.format);
+}
+
+} // namespace
+
+void OpenAssetCache(AssetCache& cache, const AssetCacheOptions& opts) {
+    cache = {};
+    if (opts.dir.empty()) return;
+    std::error_code err;
+    std::filesystem::create_directories(opts.dir, err);
+    if (err) {
+        TraceLog(LOG_WARNING, "CACHE: Failed to create %s: %s, caching disabled", opts.dir.c_str(), err.message().c_str());
+        return;
+    }
+    cache.dir = opts.dir;
+}
+
+bool LoadCachedAsset(const AssetCache& cache, const char* name, const std::string& key, const AssetDesc& desc,
+                     CachedAsset& out) {
+    out = {};
+    if (cache.dir.empty()) return false;
+    uint64_t hash = HashKey(key);
+    std::string path = EntryPath(cache, name, hash);
+    if (!MapFile(out.file, path)) return false;
+
+    const AssetCacheHeader* h = (const AssetCacheHeader*)out.file.view;
+    size_t layerSize = LayerSize(desc);
+    size_t payload = layerSize * desc.layers;
+    bool valid = out.file.size == sizeof(AssetCacheHeader) + payload && memcmp(h->magic, ASSET_CACHE_MAGIC, 4) == 0 &&
+                 h->version == ASSET_CACHE_VERSION && h->keyHash == hash && h->format == desc.format &&
+                 h->width == desc.width && h->height == desc.height && h->layers == desc.layers &&
+                 h->payloadSize == payload;
+    if (!valid) {
+        TraceLog(LOG_INFO, "CACHE: Ignoring stale %s", path.c_str());
+        UnloadCachedAsset(out);
+        return false;
+    }
+    out.data = h + 1;
+    out.layerSize = layerSize;
+    TraceLog(LOG_INFO, "CACHE: Mapped %s (%s)", path.c_str(), key.c_str());
+    return true;
+}
+
+void UnloadCachedAsset(CachedAsset& asset) {
+    UnmapFile(asset.file);
+    asset = {};
+}
+
+bool SaveCachedAsset(const AssetCache& cache, const char* name, const std::string& key, const AssetDesc& desc,
+                     const void* data) {
+    if (cache.dir.empty()) return false;
+    AssetCacheHeader h = {};
+    memcpy(h.magic, ASSET_CACHE_MAGIC, 4);
+    h.version = ASSET_CACHE_VERSION;
+    h.keyHash = HashKey(key);
+    h.format = desc.format;
+    h.width = desc.width;
+    h.height = desc.height;
+    h.layers = desc.layers;
+    h.payloadSize = LayerSize(desc) * desc.layers;
+
+    std::string path = EntryPath(cache, name, h.keyHash);
+    std::string tmp = path + ".tmp";
+    FILE* out = fopen(tmp.c_str(), "wb");
+    bool ok = out && fwrite(&h, sizeof(h), 1, out) == 1 && fwrite(data, 1, h.payloadSize, out) == h.payloadSize;
+    if (out && fclose(out) != 0) ok = false;
+    std::error_code err;
+    if (ok) std::filesystem::rename(tmp, path, err);
+    if (!ok || err) {
+        std::filesystem::remove(tmp, err);
+        TraceLog(LOG_WARNING, "CACHE: Failed to write %s", path.c_str());
+        return false;
+    }
+    TraceLog(LOG_INFO, "CACHE: Wrote %s (%s)", path.c_str(), key.c_str());
+    return true;
+}
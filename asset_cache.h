@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "mapped_file.h"
+
+// Versioned on-disk cache for generated tables and baked textures.
+//
+// One file per entry, <dir>/<name>-<key hash>.bin: a 64-byte AssetCacheHeader
+// followed by the texels exactly as they are uploaded, so a hit is a mapping
+// and a texture upload straight from it. The key string lists every parameter
+// the asset is generated from (sizes, ranges, spin, seed, ...) plus the
+// generator's own version; anything else is a miss and the caller regenerates
+// and saves. Bump ASSET_CACHE_VERSION when the file layout itself changes.
+
+struct AssetCacheOptions {
+    std::string dir = "cache";       // Created on first use; empty disables the cache
+};
+
+const char ASSET_CACHE_MAGIC[4] = {'B', 'H', 'A', 'C'};
+const uint32_t ASSET_CACHE_VERSION = 1;
+
+struct AssetCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t keyHash;                // FNV-1a of the key string
+    int32_t format;                  // raylib PixelFormat of every layer
+    int32_t width, height;
+    int32_t layers;                  // 1, or 6 cubemap faces in GL order (+X, -X, +Y, -Y, +Z, -Z)
+    uint64_t payloadSize;
+    uint32_t reserved[6];
+};
+
+static_assert(sizeof(AssetCacheHeader) == 64, "Cache header layout is part of the file format");
+
+struct AssetCache {
+    std::string dir;                 // Empty when disabled or unusable
+};
+
+// What the caller expects an entry to hold; anything else is a miss
+struct AssetDesc {
+    int format;
+    int width, height;
+    int layers = 1;
+};
+
+struct CachedAsset {
+    const void* data = nullptr;      // Payload inside the mapping
+    size_t layerSize = 0;            // Bytes per layer
+    MappedFile file;
+};
+
+// Creates the directory if needed; on failure the cache stays disabled
+void OpenAssetCache(AssetCache& cache, const AssetCacheOptions& opts);
+
+// Maps the entry for `key` if it exists and matches `desc`
+bool LoadCachedAsset(const AssetCache& cache, const char* name, const std::string& key, const AssetDesc& desc,
+                     CachedAsset& out);
+void UnloadCachedAsset(CachedAsset& asset);
+
+// Writes (or replaces) the entry; `data` holds desc.layers consecutive layers.
+// Written to a temporary file and renamed, so readers never see half an entry
+bool SaveCachedAsset(const AssetCache& cache, const char* name, const std::string& key, const AssetDesc& desc,
+                     const void* data);
@@ -0,0 +1,145 @@
+#include "benchmark.h"
+
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+struct Percentiles {
+    float min = 0.0f, mean = 0.0f, p50 = 0.0f, p90 = 0.0f, p95 = 0.0f, p99 = 0.0f, max = 0.0f;
+};
+
+Percentiles ComputePercentiles(std::vector<float> v) {
+    Percentiles p;
+    if (v.empty()) return p;
+    std::sort(v.begin(), v.end());
+    auto at = [&](float q) { return v[std::min(v.size() - 1, (size_t)(q * v.size()))]; };
+    double sum = 0.0;
+    for (float x : v) sum += x;
+    p.min = v.front();
+    p.mean = (float)(sum / v.size());
+    p.p50 = at(0.50f);
+    p.p90 = at(0.90f);
+    p.p95 = at(0.95f);
+    p.p99 = at(0.99f);
+    p.max = v.back();
+    return p;
+}
+
+void WritePercentiles(FILE* f, const Percentiles& p) {
+    fprintf(f, "{\"min\": %.4f, \"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+            p.min, p.mean, p.p50, p.p90, p.p95, p.p99, p.max);
+}
+
+// Driver strings go into JSON verbatim, so drop anything that would need escaping
+std::string JsonSafe(const unsigned char* s) {
+    std::string out;
+    for (; s && *s; s++)
+        if (*s >= 0x20 && *s != '"' && *s != '\\') out += (char)*s;
+    return out;
+}
+
+float SmoothStep(float a, float b, float t) {
+    t = fminf(fmaxf(t, 0.0f), 1.0f);
+    return a + (b - a) * t * t * (3.0f - 2.0f * t);
+}
+
+} // namespace
+
+void GetBenchmarkCamera(int frame, int total, float& angle, float& elev, float& dist) {
+    float u = (float)frame / (float)std::max(1, total);
+    angle = u * 4.0f * PI;
+    // Elevation -0.3..1.2, the same limits as the W/S keys
+    elev = 0.45f + 0.75f * sinf(u * 2.0f * PI);
+    // 16 -> 6 -> 30 -> 16, eased so the path has no velocity jumps
+    if (u < 0.25f) dist = SmoothStep(16.0f, 6.0f, u / 0.25f);
+    else if (u < 0.75f) dist = SmoothStep(6.0f, 30.0f, (u - 0.25f) / 0.5f);
+    else dist = SmoothStep(30.0f, 16.0f, (u - 0.75f) / 0.25f);
+}
+
+void CollectBenchmarkFrames(BenchmarkRun& run, const Profiler& prof, bool final) {
+    // GPU results for a frame land PROFILER_LATENCY frames after it ends
+    uint64_t settled = final ? prof.frame : (prof.frame > PROFILER_LATENCY ? prof.frame - PROFILER_LATENCY : 0);
+    for (; run.nextFrame < settled; run.nextFrame++) {
+        if (run.nextFrame < (uint64_t)run.opts.warmup) continue;
+        const ProfileFrame& f = prof.history[run.nextFrame % PROFILER_HISTORY];
+        if (f.complete && f.index == run.nextFrame) run.frames.push_back(f);
+    }
+}
+
+bool WriteBenchmarkReport(const BenchmarkRun& run, int width, int height) {
+    if (run.frames.empty()) {
+        TraceLog(LOG_ERROR, "BENCH: No frames recorded");
+        return false;
+    }
+
+    std::vector<float> frameMs, cpu[PASS_COUNT], gpu[PASS_COUNT];
+    int gpuFrames = 0;
+    for (const auto& f : run.frames) {
+        frameMs.push_back(f.frameMs);
+        for (int p = 0; p < PASS_COUNT; p++) {
+            cpu[p].push_back(f.cpuMs[p]);
+            if (f.gpuValid) gpu[p].push_back(f.gpuMs[p]);
+        }
+        gpuFrames += f.gpuValid;
+    }
+
+    Percentiles frame = ComputePercentiles(frameMs);
+    Percentiles cpuStats[PASS_COUNT], gpuStats[PASS_COUNT];
+    for (int p = 0; p < PASS_COUNT; p++) {
+        cpuStats[p] = ComputePercentiles(cpu[p]);
+        gpuStats[p] = ComputePercentiles(gpu[p]);
+    }
+    float fps = frame.mean > 0.0f ? 1000.0f / frame.mean : 0.0f;
+    std::string renderer = JsonSafe(gl::GetString(gl::RENDERER));
+    std::string version = JsonSafe(gl::GetString(gl::VERSION));
+
+    printf("benchmark: %d frames at %dx%d on %s (%s), lens stages %s, %d hole%s, %d view%s%s, %s particles\n",
+           (int)run.frames.size(), width, height, renderer.c_str(), version.c_str(), run.lensStages.c_str(), run.holes,
+           run.holes == 1 ? "" : "s", run.views, run.views == 1 ? "" : "s", run.stereo ? " (stereo)" : "",
+           run.particles.c_str());
+    printf("frame ms  min %.3f  mean %.3f  p50 %.3f  p90 %.3f  p95 %.3f  p99 %.3f  max %.3f  (%.1f fps)\n",
+           frame.min, frame.mean, frame.p50, frame.p90, frame.p95, frame.p99, frame.max, fps);
+    printf("%-16s %10s %10s %10s %10s\n", "pass", "cpu mean", "cpu p99", "gpu mean", "gpu p99");
+    for (int p = 0; p < PASS_COUNT; p++) {
+        printf("%-16s %10.3f %10.3f %10.3f %10.3f\n", GetProfilePassName((ProfilePass)p),
+               cpuStats[p].mean, cpuStats[p].p99, gpuStats[p].mean, gpuStats[p].p99);
+    }
+
+    FILE* f = fopen(run.opts.jsonPath.c_str(), "w");
+    if (!f) {
+        TraceLog(LOG_ERROR, "BENCH: Failed to open %s", run.opts.jsonPath.c_str());
+        return false;
+    }
+    fprintf(f, "{\n");
+    fprintf(f, "  \"renderer\": \"%s\",\n", renderer.c_str());
+    fprintf(f, "  \"gl_version\": \"%s\",\n", version.c_str());
+    fprintf(f, "  \"resolution\": [%d, %d],\n", width, height);
+    fprintf(f, "  \"seed\": %llu,\n", (unsigned long long)run.seed);
+    fprintf(f, "  \"lens_stages\": \"%s\",\n", run.lensStages.c_str());
+    fprintf(f, "  \"holes\": %d,\n", run.holes);
+    fprintf(f, "  \"views\": %d,\n", run.views);
+    fprintf(f, "  \"stereo\": %s,\n", run.stereo ? "true" : "false");
+    fprintf(f, "  \"particles\": \"%s\",\n", run.particles.c_str());
+    fprintf(f, "  \"frames\": %d,\n", (int)run.frames.size());
+    fprintf(f, "  \"warmup\": %d,\n", run.opts.warmup);
+    fprintf(f, "  \"gpu_frames\": %d,\n", gpuFrames);
+    fprintf(f, "  \"fps\": %.3f,\n", fps);
+    fprintf(f, "  \"frame_ms\": ");
+    WritePercentiles(f, frame);
+    fprintf(f, ",\n  \"passes\": {\n");
+    for (int p = 0; p < PASS_COUNT; p++) {
+        fprintf(f, "    \"%s\": {\"cpu_ms\": ", GetProfilePassName((ProfilePass)p));
+        WritePercentiles(f, cpuStats[p]);
+        fprintf(f, ", \"gpu_ms\": ");
+        WritePercentiles(f, gpuStats[p]);
+        fprintf(f, "}%s\n", p + 1 < PASS_COUNT ? "," : "");
+    }
+    fprintf(f, "  }\n}\n");
+    fclose(f);
+
+    TraceLog(LOG_INFO, "BENCH: Wrote %s", run.opts.jsonPath.c_str());
+    return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "profiler.h"
+
+// Deterministic benchmark run: a scripted camera path at a fixed timestep,
+// with no frame limiter and no input. Per-frame data comes from the profiler
+// and is reported once the run ends.
+
+struct BenchmarkOptions {
+    bool enabled = false;
+    int frames = 1800;               // Measured frames (30 s of simulated time)
+    int warmup = 120;                // Frames rendered first and not counted
+    std::string jsonPath = "benchmark.json";
+};
+
+const float BENCHMARK_DT = 1.0f / 60.0f;
+
+// Camera at frame `frame` of `total`: two full orbits, a zoom from the
+// default distance in to 6 and out to 30, and an elevation sweep over the
+// full interactive range. Offline export flies the same path. Benchmark
+// warmup frames come before frame 0 and hold its pose.
+void GetBenchmarkCamera(int frame, int total, float& angle, float& elev, float& dist);
+
+struct BenchmarkRun {
+    BenchmarkOptions opts;
+    std::vector<ProfileFrame> frames;
+    uint64_t nextFrame = 0;          // First profiler frame not yet copied
+    uint64_t seed = 0;               // Scene seed, recorded so runs can be compared
+    std::string lensStages;          // Lensing stages compiled in (--lens-stages)
+    int holes = 1;                   // Black holes in the scene (--holes)
+    int views = 1;                   // Views in the atlas (--views, --stereo)
+    bool stereo = false;
+    std::string particles;           // Disk particle path after any fallback (--particles)
+};
+
+// Copies frames whose GPU timings have settled; `final` takes everything up
+// to the current frame (call FinishProfiler first)
+void CollectBenchmarkFrames(BenchmarkRun& run, const Profiler& prof, bool final);
+
+// Prints a summary to stdout and writes the JSON report
+bool WriteBenchmarkReport(const BenchmarkRun& run, int width, int height);
@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "disk_color.h"
+#include "job_system.h"
+#include "line_geometry.h"
+#include "particle_kernel.h"
+#include "scene_gen.h"
+
+// blackhole-bench: the CPU hot paths of the simulation, timed without a
+// window or GL context. Generation and the parallel particle update run with
+// one worker and with one per core (the second argument, 0), so threading
+// changes show up as the ratio between the two.
+
+namespace {
+
+const float BENCH_DISK_INNER = 2.5f;  // The scene's disk, as in main.cpp
+const float BENCH_DISK_OUTER = 9.0f;
+const float BENCH_DT = 1.0f / 120.0f;
+
+// Element counts from 1k to 10M, each with one worker and with all cores
+void GenerationArgs(benchmark::internal::Benchmark* b) {
+    for (int n = 1000; n <= 10000000; n *= 10) {
+        b->Args({n, 1});
+        b->Args({n, 0});
+    }
+}
+
+// One GetDiskColor() per texel of the disk LUT
+void BM_GetDiskColor(benchmark::State& state) {
+    for (auto _ : state) {
+        for (int j = 0; j < DISK_LUT_DOPPLER_SIZE; j++) {
+            float doppler = DISK_LUT_DOPPLER_MIN +
+                (float)j / (DISK_LUT_DOPPLER_SIZE - 1) * (DISK_LUT_DOPPLER_MAX - DISK_LUT_DOPPLER_MIN);
+            for (int i = 0; i < DISK_LUT_TEMP_SIZE; i++) {
+                benchmark::DoNotOptimize(GetDiskColor((float)i / (DISK_LUT_TEMP_SIZE - 1), doppler));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * DISK_LUT_TEMP_SIZE * DISK_LUT_DOPPLER_SIZE);
+}
+BENCHMARK(BM_GetDiskColor);
+
+// Both LUTs, as on a cache miss at startup
+void BM_FillDiskColorLUT(benchmark::State& state) {
+    std::vector<Color> texels(DISK_LUT_TEMP_SIZE * DISK_LUT_DOPPLER_SIZE);
+    std::vector<float> radiance;
+    for (auto _ : state) {
+        FillDiskColorLUT(texels, radiance);
+        benchmark::DoNotOptimize(texels.data());
+        benchmark::DoNotOptimize(radiance.data());
+    }
+    state.SetItemsProcessed(state.iterations() * texels.size());
+}
+BENCHMARK(BM_FillDiskColorLUT);
+
+void BM_CreateStars(benchmark::State& state) {
+    JobSystem jobs;
+    StartJobSystem(jobs, (int)state.range(1));
+    for (auto _ : state) {
+        std::vector<Star> stars = CreateStars(jobs, (int)state.range(0), SCENE_SEED_DEFAULT);
+        benchmark::DoNotOptimize(stars.data());
+    }
+    StopJobSystem(jobs);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreateStars)->Apply(GenerationArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_CreateDisk(benchmark::State& state) {
+    JobSystem jobs;
+    StartJobSystem(jobs, (int)state.range(1));
+    for (auto _ : state) {
+        std::vector<Particle> disk = CreateDisk(jobs, (int)state.range(0), BENCH_DISK_INNER, BENCH_DISK_OUTER,
+                                                SCENE_SEED_DEFAULT, RNG_STREAM_CPU_DISK);
+        benchmark::DoNotOptimize(disk.data());
+    }
+    StopJobSystem(jobs);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreateDisk)->Apply(GenerationArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+ParticleSoA MakeBenchDisk(int n) {
+    JobSystem jobs;
+    StartJobSystem(jobs);
+    ParticleSoA soa = LoadParticleSoA(
+        CreateDisk(jobs, n, BENCH_DISK_INNER, BENCH_DISK_OUTER, SCENE_SEED_DEFAULT, RNG_STREAM_CPU_DISK),
+        BENCH_DISK_INNER, 0.4f, 1.8f);
+    StopJobSystem(jobs);
+    return soa;
+}
+
+// The SIMD kernel on the calling thread; the label names the kernel picked
+void BM_UpdateParticles(benchmark::State& state) {
+    ParticleSoA soa = MakeBenchDisk((int)state.range(0));
+    std::vector<ParticleVertex> out(soa.count);
+    for (auto _ : state) {
+        UpdateParticles(soa, BENCH_DT, -0.5f * BENCH_DT, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * soa.count);
+    state.SetLabel(GetParticleKernelName());
+}
+BENCHMARK(BM_UpdateParticles)->RangeMultiplier(10)->Range(1000, 10000000);
+
+// The frame's update as main.cpp issues it: CPU_PARTICLE_GRAIN chunks on the job system
+void BM_UpdateParticlesParallel(benchmark::State& state) {
+    ParticleSoA soa = MakeBenchDisk((int)state.range(0));
+    std::vector<ParticleVertex> out(soa.count);
+    ParticleVertex* verts = out.data();
+    JobSystem jobs;
+    StartJobSystem(jobs, (int)state.range(1));
+    for (auto _ : state) {
+        JobGroup group;
+        ParallelFor(jobs, group, soa.count, CPU_PARTICLE_GRAIN, [&soa, verts](int begin, int end) {
+            UpdateParticleRange(soa, begin, end, BENCH_DT, -0.5f * BENCH_DT, verts);
+        });
+        WaitJobGroup(jobs, group);
+        benchmark::DoNotOptimize(verts);
+    }
+    StopJobSystem(jobs);
+    state.SetItemsProcessed(state.iterations() * soa.count);
+    state.SetLabel(GetParticleKernelName());
+}
+BENCHMARK(BM_UpdateParticlesParallel)->Apply(GenerationArgs)->UseRealTime();
+
+// Every ring group at every LOD level, as LoadLineMesh() builds them
+void BM_BuildLineGeometry(benchmark::State& state) {
+    size_t vertices = 0;
+    for (auto _ : state) {
+        LineGeometry geo = BuildLineGeometry(1.0f, BENCH_DISK_INNER, BENCH_DISK_OUTER);
+        vertices = geo.vertices.size();
+        benchmark::DoNotOptimize(geo.vertices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * vertices);
+}
+BENCHMARK(BM_BuildLineGeometry);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,23 @@
+#version 330
+
+// Separable 9-tap Gaussian (σ ≈ 2 texels) using 5 bilinear fetches
+// Run once horizontally and once vertically per bloom level
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform vec2 direction;   // texel step along the blur axis: (1/w, 0) or (0, 1/h)
+
+// Discrete binomial 9-tap weights folded pairwise into linear-filtered taps
+// at fractional offsets (two texels per fetch)
+const float OFFSETS[3] = float[](0.0, 1.3846153846, 3.2307692308);
+const float WEIGHTS[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+
+void main() {
+    vec3 sum = texture(texture0, fragTexCoord).rgb * WEIGHTS[0];
+    for (int i = 1; i < 3; i++) {
+        sum += texture(texture0, fragTexCoord + direction * OFFSETS[i]).rgb * WEIGHTS[i];
+        sum += texture(texture0, fragTexCoord - direction * OFFSETS[i]).rgb * WEIGHTS[i];
+    }
+    finalColor = vec4(sum, 1.0);
+}
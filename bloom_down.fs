@@ -0,0 +1,33 @@
+#version 330
+
+// Bloom chain downsample: 4 bilinear taps at ±1 source texel (a 4x4 box)
+// The first step from the full-res scene also applies the bright-pass threshold,
+// so the threshold is evaluated at half resolution instead of per screen pixel
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform vec2 texelSize;   // 1 / source resolution
+uniform int brightPass;   // 1 on the first (scene -> half-res) step
+
+const float BLOOM_THRESHOLD = 0.4;
+
+vec3 prefilter(vec3 c) {
+    // Only bright pixels contribute, weighted by how far they exceed the threshold.
+    // Above 1 (HDR scene target) the weight levels off so highlights bloom linearly
+    float brightness = dot(c, vec3(0.299, 0.587, 0.114));
+    return c * max(brightness - BLOOM_THRESHOLD, 0.0) / max(brightness, 1.0) * 0.5;
+}
+
+void main() {
+    vec3 a = texture(texture0, fragTexCoord + vec2(-1.0, -1.0) * texelSize).rgb;
+    vec3 b = texture(texture0, fragTexCoord + vec2( 1.0, -1.0) * texelSize).rgb;
+    vec3 c = texture(texture0, fragTexCoord + vec2(-1.0,  1.0) * texelSize).rgb;
+    vec3 d = texture(texture0, fragTexCoord + vec2( 1.0,  1.0) * texelSize).rgb;
+
+    if (brightPass == 1) {
+        a = prefilter(a); b = prefilter(b); c = prefilter(c); d = prefilter(d);
+    }
+
+    finalColor = vec4((a + b + c + d) * 0.25, 1.0);
+}
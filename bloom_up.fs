@@ -0,0 +1,22 @@
+#version 330
+
+// Bloom chain upsample: 3x3 tent filter of the lower level
+// Drawn with additive blending onto the next larger level
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform vec2 texelSize;   // 1 / source (lower level) resolution
+
+void main() {
+    vec3 sum = texture(texture0, fragTexCoord).rgb * 4.0;
+    sum += texture(texture0, fragTexCoord + vec2(-1.0,  0.0) * texelSize).rgb * 2.0;
+    sum += texture(texture0, fragTexCoord + vec2( 1.0,  0.0) * texelSize).rgb * 2.0;
+    sum += texture(texture0, fragTexCoord + vec2( 0.0, -1.0) * texelSize).rgb * 2.0;
+    sum += texture(texture0, fragTexCoord + vec2( 0.0,  1.0) * texelSize).rgb * 2.0;
+    sum += texture(texture0, fragTexCoord + vec2(-1.0, -1.0) * texelSize).rgb;
+    sum += texture(texture0, fragTexCoord + vec2( 1.0, -1.0) * texelSize).rgb;
+    sum += texture(texture0, fragTexCoord + vec2(-1.0,  1.0) * texelSize).rgb;
+    sum += texture(texture0, fragTexCoord + vec2( 1.0,  1.0) * texelSize).rgb;
+    finalColor = vec4(sum / 16.0, 1.0);
+}
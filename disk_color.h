@@ -0,0 +1,44 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <string>
+#include <vector>
+
+// Accretion disk colour model, shared by every disk consumer: the rings and
+// particles sample it through the LUT main.cpp uploads, and the CPU particle
+// kernel uses the same Doppler factor. Pure CPU code, no GL context needed.
+
+// Blackbody radiation color gradient for accretion disk
+// Based on Wien's displacement law: hotter regions emit shorter wavelengths
+const Color DISK_HOT = {255, 255, 240, 255};      // ~10,000K - Near peak emission
+const Color DISK_MID = {255, 200, 100, 255};      // ~5,000K - Solar temperature
+const Color DISK_COLD = {200, 80, 30, 255};       // ~3,000K - Red dwarf range
+
+// Disk color at temperature t ∈ [0, 1] (0 at the inner edge) and Doppler factor D,
+// in [0, 1] display units and unclamped: beaming pushes channels past 1
+Vector3 GetDiskRadiance(float t, float doppler);
+
+// 8-bit disk color; highlights clip at white
+Color GetDiskColor(float t, float doppler);
+
+// Relativistic Doppler: D = √[(1+β·cosθ)/(1-β·cosθ)], clamped to [dMin, dMax]
+float DopplerFactor(float beta, float cosAngle, float dMin, float dMax);
+
+// Disk color lookup table: GetDiskColor() tabulated over temperature t ∈ [0, 1]
+// (columns) and Doppler factor D (rows). Lives both as a CPU array and as a GPU
+// texture so every disk color consumer does a single fetch; swapping the
+// color model only means refilling the table.
+const int DISK_LUT_TEMP_SIZE = 256;
+const int DISK_LUT_DOPPLER_SIZE = 128;
+// Widest Doppler clamp used by any disk consumer (disk rings / particles)
+const float DISK_LUT_DOPPLER_MIN = 0.4f;
+const float DISK_LUT_DOPPLER_MAX = 1.8f;
+
+// Both tables from GetDiskColor() / GetDiskRadiance(), row-major by D;
+// `texels` must hold DISK_LUT_TEMP_SIZE * DISK_LUT_DOPPLER_SIZE entries and
+// `radiance` is resized to match as RGBA32F
+void FillDiskColorLUT(std::vector<Color>& texels, std::vector<float>& radiance);
+
+// Cache key of both tables; bump the version when GetDiskRadiance() changes
+std::string GetDiskColorLUTKey();
@@ -0,0 +1,134 @@
+#include "disk_sim.h"
+
+#include <algorithm>
+
+#include <raylib.h>
+
+#include "gl_ext.h"
+
+namespace {
+
+const int LOCAL_SIZE = 256;  // Must match local_size_x in disk_sim.comp
+
+// Compiles and links a compute program; 0 (with the log reported) on failure
+gl::GLuint LoadComputeProgram(const char* path) {
+    char* source = LoadFileText(path);
+    if (!source) {
+        TraceLog(LOG_ERROR, "DISKSIM: Failed to read %s", path);
+        return 0;
+    }
+    char log[1024];
+    gl::GLuint shader = gl::CreateShader(gl::COMPUTE_SHADER);
+    gl::ShaderSource(shader, 1, &source, nullptr);
+    gl::CompileShader(shader);
+    UnloadFileText(source);
+    gl::GLint ok = 0;
+    gl::GetShaderiv(shader, gl::COMPILE_STATUS, &ok);
+    if (!ok) {
+        gl::GetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        TraceLog(LOG_ERROR, "DISKSIM: %s failed to compile: %s", path, log);
+        gl::DeleteShader(shader);
+        return 0;
+    }
+
+    gl::GLuint program = gl::CreateProgram();
+    gl::AttachShader(program, shader);
+    gl::LinkProgram(program);
+    gl::DeleteShader(shader);  // Freed with the program
+    gl::GetProgramiv(program, gl::LINK_STATUS, &ok);
+    if (!ok) {
+        gl::GetProgramInfoLog(program, sizeof(log), nullptr, log);
+        TraceLog(LOG_ERROR, "DISKSIM: %s failed to link: %s", path, log);
+        gl::DeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+} // namespace
+
+DiskSim LoadDiskSim(const char* computePath) {
+    DiskSim sim;
+    if (!gl::LoadComputeExtensions()) {
+        TraceLog(LOG_INFO, "DISKSIM: No GL 4.3 compute shaders, simulated disk unavailable");
+        return sim;
+    }
+    sim.program = LoadComputeProgram(computePath);
+    if (!sim.program) return sim;
+
+    sim.countLoc = gl::GetUniformLocation(sim.program, "count");
+    sim.simulatedLoc = gl::GetUniformLocation(sim.program, "simulated");
+    sim.stepsLoc = gl::GetUniformLocation(sim.program, "steps");
+    sim.dtLoc = gl::GetUniformLocation(sim.program, "dt");
+    sim.firstStepLoc = gl::GetUniformLocation(sim.program, "firstStep");
+    sim.innerLoc = gl::GetUniformLocation(sim.program, "diskInner");
+    sim.outerLoc = gl::GetUniformLocation(sim.program, "diskOuter");
+    sim.seedLoc = gl::GetUniformLocation(sim.program, "seed");
+
+    gl::GenBuffers(2, sim.buffers);
+    gl::GenVertexArrays(2, sim.vaos);
+    sim.supported = true;
+    return sim;
+}
+
+void UnloadDiskSim(DiskSim& sim) {
+    if (sim.supported) {
+        gl::DeleteVertexArrays(2, sim.vaos);
+        gl::DeleteBuffers(2, sim.buffers);
+    }
+    if (sim.program) gl::DeleteProgram(sim.program);
+    sim = {};
+}
+
+void ResetDiskSim(DiskSim& sim, const std::vector<Particle>& particles) {
+    static_assert(sizeof(DiskSimParticle) == 4 * sizeof(float), "DiskSimParticle must map to a std430 vec4");
+    if (!sim.supported) return;
+
+    std::vector<DiskSimParticle> state(particles.size());
+    for (size_t i = 0; i < particles.size(); i++) {
+        state[i] = {particles[i].angle, particles[i].radius, 0.0f, particles[i].yOffset};
+    }
+    sim.count = (int)state.size();
+    sim.front = 0;
+    for (int b = 0; b < 2; b++) {
+        gl::BindVertexArray(sim.vaos[b]);
+        gl::BindBuffer(gl::ARRAY_BUFFER, sim.buffers[b]);
+        gl::BufferData(gl::ARRAY_BUFFER, state.size() * sizeof(DiskSimParticle), state.data(), gl::DYNAMIC_DRAW);
+        gl::VertexAttribPointer(0, 4, gl::FLOAT, false, sizeof(DiskSimParticle), (void*)0);
+        gl::EnableVertexAttribArray(0);
+    }
+    gl::BindVertexArray(0);
+    gl::BindBuffer(gl::ARRAY_BUFFER, 0);
+}
+
+void StepDiskSim(DiskSim& sim, int simulated, int steps, float dt, unsigned int firstStep, float diskInner, float diskOuter,
+                 unsigned int seed) {
+    if (!sim.supported || steps <= 0 || sim.count <= 0) return;
+
+    gl::UseProgram(sim.program);
+    gl::Uniform1i(sim.countLoc, sim.count);
+    gl::Uniform1i(sim.simulatedLoc, std::clamp(simulated, 0, sim.count));
+    gl::Uniform1i(sim.stepsLoc, steps);
+    gl::Uniform1f(sim.dtLoc, dt);
+    gl::Uniform1ui(sim.firstStepLoc, firstStep);
+    gl::Uniform1f(sim.innerLoc, diskInner);
+    gl::Uniform1f(sim.outerLoc, diskOuter);
+    gl::Uniform1ui(sim.seedLoc, seed);
+    gl::BindBufferBase(gl::SHADER_STORAGE_BUFFER, 0, sim.buffers[sim.front]);
+    gl::BindBufferBase(gl::SHADER_STORAGE_BUFFER, 1, sim.buffers[sim.front ^ 1]);
+    gl::DispatchCompute((sim.count + LOCAL_SIZE - 1) / LOCAL_SIZE, 1, 1);
+    gl::BindBufferBase(gl::SHADER_STORAGE_BUFFER, 0, 0);
+    gl::BindBufferBase(gl::SHADER_STORAGE_BUFFER, 1, 0);
+    gl::UseProgram(0);
+
+    // The draw reads the new state as vertices, the next dispatch as storage
+    gl::MemoryBarrier(gl::VERTEX_ATTRIB_ARRAY_BARRIER_BIT | gl::SHADER_STORAGE_BARRIER_BIT);
+    sim.front ^= 1;
+}
+
+void DrawDiskSim(const DiskSim& sim, int first, int count, int views) {
+    if (!sim.supported) return;
+    gl::BindVertexArray(sim.vaos[sim.front]);
+    gl::DrawArraysInstanced(gl::POINTS, first, std::max(0, std::min(count, sim.count - first)), views);
+    gl::BindVertexArray(0);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "particle_kernel.h"
+
+// Simulated accretion disk (particle path "Sim", GL 4.3+). disk_sim.comp
+// integrates every particle's orbit on the GPU: Keplerian angular motion, the
+// inward drift and random-walk spreading of a viscous disk, a turbulent
+// vertical wobble, the plunge inside the ISCO and a respawn near diskOuter
+// for each particle the hole swallows. State ping-pongs between two shader
+// storage buffers and the newest one is drawn in place as the vertex buffer
+// of particles_sim.vs, so particles never travel back to the CPU.
+//
+// Per-particle state, one vec4: angle (radians), radius (Rs), radial velocity
+// (Rs per second of simulation time), height above the disk plane.
+
+struct DiskSimParticle { float angle, radius, vr, height; };
+
+struct DiskSim {
+    bool supported = false;          // Context has compute shaders and the program linked
+    unsigned int program = 0;
+    unsigned int buffers[2] = {0, 0};
+    unsigned int vaos[2] = {0, 0};   // Each buffer as a vertex attribute
+    int front = 0;                   // Buffer holding the latest state
+    int count = 0;
+    int countLoc, simulatedLoc, stepsLoc, dtLoc, firstStepLoc, innerLoc, outerLoc, seedLoc;
+};
+
+// Returns a sim with `supported` false (and nothing allocated) on a context
+// without GL 4.3 compute; call after gl::LoadExtensions()
+DiskSim LoadDiskSim(const char* computePath);
+void UnloadDiskSim(DiskSim& sim);
+
+// Replaces the state with `particles` at rest in their orbits (vr = 0)
+void ResetDiskSim(DiskSim& sim, const std::vector<Particle>& particles);
+
+// Advances the particles by `steps` steps of `dt`; `firstStep` numbers the
+// first of them, so the random walk depends on the step and not on how steps
+// fell into frames. Only the first `simulated` (the drawn prefix) get the
+// full model; the rest just keep orbiting, so they reappear in place when the
+// quality level draws them again. Swaps the buffers and issues the barrier
+// the draw needs. Does nothing for zero steps.
+void StepDiskSim(DiskSim& sim, int simulated, int steps, float dt, unsigned int firstStep, float diskInner, float diskOuter,
+                 unsigned int seed);
+
+// Caller must have particles_sim.vs bound (rlEnableShader)
+void DrawDiskSim(const DiskSim& sim, int first, int count, int views);
@@ -0,0 +1,144 @@
+#version 330
+
+// Volumetric accretion disk [V], ray marched per pixel of a full-screen
+// triangle (skybox.vs supplies the view direction)
+// Rays follow the Schwarzschild null geodesic the deflection table is
+// integrated from, so they bend as lensModel 1 predicts and rays that fall
+// through the horizon leave the shadow. The result is composited by
+// lensing.fs after its own (screen-space) deflection, never bent twice.
+in vec3 viewDir;
+layout(location = 0) out vec4 volumeColor;  // Premultiplied radiance, opacity
+layout(location = 1) out float volumeDepth; // Opacity-weighted path length
+
+uniform vec3 cameraPos;
+uniform int epoch;             // Index of the current epoch, see GPU_TIME_EPOCH in main.cpp
+uniform float epochLength;
+uniform float time;            // Seconds since it started
+uniform float diskInner;
+uniform float diskOuter;
+uniform sampler2D diskLUT;     // GetDiskColor() tabulated over (t, D)
+uniform vec2 lutDopplerRange;
+
+const int MAX_STEPS = 192;
+const float STEP_MIN = 0.03;      // World units, in the densest gas
+const float STEP_MAX = 0.3;       // Inside the disk shell but in thin gas
+const float BEND_STEP = 0.1;      // Step limit as a fraction of r: bends within 2% of the table for b >= 4 Rs
+const float OPAQUE = 0.99;        // Opacity at which the march stops
+const float DISK_FLARE = 0.08;    // Scale height h / r: the disk thickens outwards
+const float SHELL_HEIGHTS = 3.0;  // Gas beyond this many scale heights is ignored
+const float EXTINCTION = 2.5;     // Per world unit at unit density
+const float NOISE_SCALE = 0.9;
+const float NO_HIT_DEPTH = 1000.0;
+const float TWO_PI = 6.28318530718;
+
+// Same addressing as sampleDiskLUT() in line.vs
+vec3 sampleDiskLUT(float t, float doppler) {
+    vec2 size = vec2(textureSize(diskLUT, 0));
+    vec2 uv = vec2(t, (doppler - lutDopplerRange.x) / (lutDopplerRange.y - lutDopplerRange.x));
+    uv = (clamp(uv, 0.0, 1.0) * (size - 1.0) + 0.5) / size;
+    return textureLod(diskLUT, uv, 0.0).rgb;
+}
+
+// Value noise and a three-octave fbm for the turbulence
+float hash(vec3 p) {
+    p = fract(p * 0.3183099 + 0.1);
+    p *= 17.0;
+    return fract(p.x * p.y * p.z * (p.x + p.y + p.z));
+}
+
+float noise(vec3 x) {
+    vec3 i = floor(x);
+    vec3 f = fract(x);
+    f = f * f * (3.0 - 2.0 * f);
+    return mix(mix(mix(hash(i), hash(i + vec3(1, 0, 0)), f.x),
+                   mix(hash(i + vec3(0, 1, 0)), hash(i + vec3(1, 1, 0)), f.x), f.y),
+               mix(mix(hash(i + vec3(0, 0, 1)), hash(i + vec3(1, 0, 1)), f.x),
+                   mix(hash(i + vec3(0, 1, 1)), hash(i + vec3(1, 1, 1)), f.x), f.y), f.z);
+}
+
+float fbm(vec3 p) {
+    return 0.5 * noise(p) + 0.3 * noise(p * 2.03) + 0.2 * noise(p * 4.01);
+}
+
+// Gas density at p (rc: cylindrical radius). Gaussian vertical profile with a
+// flaring scale height, soft radial edges and turbulence that orbits at the
+// Keplerian rate of the particles (ω = 2/√r), so inner rings shear past outer ones
+float diskDensity(vec3 p, float rc) {
+    float h = DISK_FLARE * rc;
+    float vertical = exp(-0.5 * p.y * p.y / (h * h));
+    float radial = smoothstep(diskInner * 0.9, diskInner * 1.1, rc) * (1.0 - smoothstep(diskOuter * 0.75, diskOuter, rc));
+    if (vertical * radial < 1e-3) return 0.0;
+
+    // Whole epochs as a fraction of a turn, as in particles.vs. Turns per
+    // epoch are only rounded to float here, which offsets the swirl smoothly
+    // in rc rather than stepping it in time
+    float omega = 2.0 / sqrt(rc);
+    float epochTurns = fract(float(epoch) * fract(omega * epochLength / TWO_PI));
+    float a = TWO_PI * epochTurns + omega * time;
+    float c = cos(a), s = sin(a);
+    vec3 q = vec3(c * p.x + s * p.z, p.y, c * p.z - s * p.x);
+    float turbulence = clamp(fbm(q * NOISE_SCALE) * 1.8 - 0.35, 0.0, 1.0);
+    // Denser towards the inner edge, like the particles' t² bias
+    return vertical * radial * turbulence * (diskInner / rc);
+}
+
+void main() {
+    vec3 pos = cameraPos;
+    vec3 vel = normalize(viewDir);
+    // Photon orbit in Cartesian form (Rs = 1): x'' = -1.5·h²·x / r⁵ with the
+    // conserved h = |x × x'|; same equation as IntegrateDeflection()
+    vec3 hv = cross(pos, vel);
+    float h2 = dot(hv, hv);
+
+    // Bounding shell of the gas: an annulus SHELL_HEIGHTS scale heights thick
+    float shellInner = diskInner * 0.9;
+    float shellHeight = SHELL_HEIGHTS * DISK_FLARE * diskOuter;
+
+    vec3 color = vec3(0.0);
+    float transmittance = 1.0;
+    float depthSum = 0.0;
+    float path = 0.0;
+    for (int i = 0; i < MAX_STEPS; i++) {
+        float r = length(pos);
+        if (r < 1.0) break;  // Through the horizon
+
+        float rc = length(pos.xz);
+        // Lower bound on the distance to the shell: empty space is crossed in one step
+        float shell = max(max(abs(pos.y) - shellHeight, rc - diskOuter), shellInner - rc);
+        float ds;
+        if (shell > 0.0) {
+            // Outside the disk and moving away: nothing left to hit
+            if (r > diskOuter && dot(pos, vel) > 0.0) break;
+            ds = max(shell, STEP_MIN);
+        } else {
+            float sigma = diskDensity(pos, rc) * EXTINCTION;
+            // Adaptive step: fine where the gas is dense, coarse where it is thin
+            ds = min(mix(STEP_MAX, STEP_MIN, clamp(sigma * 2.0, 0.0, 1.0)), BEND_STEP * r);
+            if (sigma > 0.0) {
+                float t = (rc - diskInner) / (diskOuter - diskInner);
+                float beta = 0.4 / sqrt(rc / diskInner);
+                float cosAngle = pos.x / rc;  // Same convention as particles.vs
+                float doppler = clamp(sqrt((1.0 + beta * cosAngle) / (1.0 - beta * cosAngle + 0.01)),
+                                      lutDopplerRange.x, lutDopplerRange.y);
+                float alpha = 1.0 - exp(-sigma * ds);
+                color += transmittance * alpha * sampleDiskLUT(t, doppler);
+                depthSum += transmittance * alpha * path;
+                transmittance *= 1.0 - alpha;
+                if (transmittance < 1.0 - OPAQUE) break;
+            }
+        }
+        ds = min(ds, BEND_STEP * r);
+
+        // Symplectic Euler in the affine parameter; |x'| grows near the hole,
+        // so the parameter step is scaled to keep ds in world units
+        float speed = length(vel);
+        float dl = ds / speed;
+        vel += -1.5 * h2 * pos / (r * r * r * r * r) * dl;
+        pos += vel * dl;
+        path += ds;
+    }
+
+    float opacity = 1.0 - transmittance;
+    volumeColor = vec4(color, opacity);
+    volumeDepth = opacity > 0.0 ? depthSum / opacity : NO_HIT_DEPTH;
+}
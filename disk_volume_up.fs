@@ -0,0 +1,37 @@
+#version 330
+
+// Depth-aware 2x upsample of the half-resolution disk volume
+// Bilinear over the four nearest texels, but a texel whose path length differs
+// from the nearest one is down-weighted, so the front of the disk doesn't bleed
+// into the lensed arc behind it or into the shadow (NO_HIT_DEPTH)
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform sampler2D texture0;     // Premultiplied radiance, opacity
+uniform sampler2D volumeDepth;
+uniform vec2 sourceSize;        // Volume resolution in texels
+
+const float DEPTH_TOLERANCE = 0.1;  // Relative depth difference that cuts a tap's weight to 1/e
+
+void main() {
+    vec2 p = fragTexCoord * sourceSize - 0.5;
+    vec2 f = fract(p);
+    ivec2 base = ivec2(floor(p));
+    ivec2 hi = ivec2(sourceSize) - 1;
+    float ref = texelFetch(volumeDepth, clamp(base + ivec2(step(0.5, f)), ivec2(0), hi), 0).r;
+
+    vec4 sum = vec4(0.0);
+    float weightSum = 0.0;
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 2; i++) {
+            ivec2 c = clamp(base + ivec2(i, j), ivec2(0), hi);
+            float w = (i == 0 ? 1.0 - f.x : f.x) * (j == 0 ? 1.0 - f.y : f.y);
+            float d = texelFetch(volumeDepth, c, 0).r;
+            w *= exp(-abs(d - ref) / (DEPTH_TOLERANCE * max(ref, 1.0)));
+            sum += texelFetch(texture0, c, 0) * w;
+            weightSum += w;
+        }
+    }
+    // The nearest texel always keeps at least a quarter of its weight
+    finalColor = sum / weightSum;
+}
@@ -0,0 +1,203 @@
+#include "exporter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#if defined(_WIN32)
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace {
+
+void WorkerLoop(FrameExporter& ex) {
+    for (;;) {
+        ExportJob job;
+        {
+            std::unique_lock<std::mutex> lock(ex.mutex);
+            ex.jobReady.wait(lock, [&] { return ex.stopping || !ex.queue.empty(); });
+            if (ex.queue.empty()) return;
+            job = std::move(ex.queue.front());
+            ex.queue.pop_front();
+        }
+
+        bool ok;
+        if (ex.pipe) {
+            ok = fwrite(job.pixels.data(), 1, job.pixels.size(), ex.pipe) == job.pixels.size();
+        } else {
+            // The lensing pass leaves blended alpha behind; frames are opaque
+            for (size_t i = 3; i < job.pixels.size(); i += 4) job.pixels[i] = 255;
+            Image img = {job.pixels.data(), ex.opts.width, ex.opts.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+            // TextFormat's buffers are shared, so not usable from workers, and
+            // ExportImage() goes through IsFileExtension(), whose TextToLower()
+            // and TextSplit() buffers are too: encode in memory and write here
+            char name[32];
+            snprintf(name, sizeof(name), "frame_%05d.png", job.frame);
+            std::string file = (std::filesystem::path(ex.opts.path) / name).string();
+            int size = 0;
+            unsigned char* png = ExportImageToMemory(img, ".png", &size);
+            FILE* out = png ? fopen(file.c_str(), "wb") : nullptr;
+            ok = out && fwrite(png, 1, size, out) == (size_t)size;
+            if (out && fclose(out) != 0) ok = false;
+            MemFree(png);
+        }
+
+        std::lock_guard<std::mutex> lock(ex.mutex);
+        if (!ok && !ex.failed) TraceLog(LOG_ERROR, "EXPORT: Failed to write frame %d", job.frame);
+        ex.failed = ex.failed || !ok;
+        ex.freeBuffers.push_back(std::move(job.pixels));
+        ex.jobDone.notify_one();
+    }
+}
+
+// Maps a completed PBO slot, flips it to top-down rows and queues it
+void HandOff(FrameExporter& ex, int slot) {
+    size_t rowBytes = (size_t)ex.opts.width * 4;
+    std::vector<unsigned char> pixels;
+    {
+        // Back-pressure: wait for a worker instead of growing the queue without bound
+        std::unique_lock<std::mutex> lock(ex.mutex);
+        ex.jobDone.wait(lock, [&] { return ex.queue.size() < (size_t)EXPORT_QUEUE_DEPTH; });
+        if (!ex.freeBuffers.empty()) {
+            pixels = std::move(ex.freeBuffers.back());
+            ex.freeBuffers.pop_back();
+        }
+    }
+    pixels.resize(rowBytes * ex.opts.height);
+
+    bool mapped = false;
+    gl::BindBuffer(gl::PIXEL_PACK_BUFFER, ex.pbo[slot]);
+    const unsigned char* src = (const unsigned char*)gl::MapBufferRange(gl::PIXEL_PACK_BUFFER, 0,
+                                                                       rowBytes * ex.opts.height, gl::MAP_READ_BIT);
+    if (src) {
+        for (int y = 0; y < ex.opts.height; y++)
+            memcpy(&pixels[y * rowBytes], src + (size_t)(ex.opts.height - 1 - y) * rowBytes, rowBytes);
+        mapped = gl::UnmapBuffer(gl::PIXEL_PACK_BUFFER);
+    }
+    if (!mapped) TraceLog(LOG_ERROR, "EXPORT: Failed to map readback buffer for frame %d", ex.slotFrame[slot]);
+    gl::BindBuffer(gl::PIXEL_PACK_BUFFER, 0);
+    gl::DeleteSync(ex.fence[slot]);
+    ex.fence[slot] = nullptr;
+
+    std::lock_guard<std::mutex> lock(ex.mutex);
+    if (!mapped) {
+        ex.failed = true;
+        ex.freeBuffers.push_back(std::move(pixels));
+        return;
+    }
+    ex.queue.push_back({ex.slotFrame[slot], std::move(pixels)});
+    ex.written++;
+    ex.jobReady.notify_one();
+}
+
+// Returns true once the slot's readback has landed; with `wait` it blocks on the fence
+bool SlotReady(FrameExporter& ex, int slot, bool wait) {
+    gl::GLuint64 timeout = wait ? 1000000000ull : 0;
+    gl::GLenum r = gl::ClientWaitSync(ex.fence[slot], gl::SYNC_FLUSH_COMMANDS_BIT, timeout);
+    return r == gl::ALREADY_SIGNALED || r == gl::CONDITION_SATISFIED;
+}
+
+} // namespace
+
+bool IsVideoExportPath(const std::string& path) {
+    std::string ext = std::filesystem::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)tolower(c); });
+    return ext == ".mp4" || ext == ".mkv" || ext == ".mov" || ext == ".webm";
+}
+
+bool StartExport(FrameExporter& ex, const ExportOptions& opts) {
+    ex.opts = opts;
+    int workerCount = 1;
+
+    if (IsVideoExportPath(opts.path)) {
+        std::string cmd = TextFormat("ffmpeg -loglevel error -y -f rawvideo -pix_fmt rgba -s %dx%d -r %d -i - "
+                                     "-c:v libx264 -preset slow -crf 16 -pix_fmt yuv420p \"%s\"",
+                                     opts.width, opts.height, opts.fps, opts.path.c_str());
+#if defined(_WIN32)
+        ex.pipe = popen(cmd.c_str(), "wb");
+#else
+        ex.pipe = popen(cmd.c_str(), "w");
+#endif
+        if (!ex.pipe) {
+            TraceLog(LOG_ERROR, "EXPORT: Failed to start ffmpeg");
+            return false;
+        }
+    } else {
+        std::error_code err;
+        std::filesystem::create_directories(opts.path, err);
+        if (err) {
+            TraceLog(LOG_ERROR, "EXPORT: Failed to create %s: %s", opts.path.c_str(), err.message().c_str());
+            return false;
+        }
+        // PNG frames are independent, so compress several at once
+        // (hardware_concurrency() may report 0 when unknown)
+        workerCount = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+    }
+
+    size_t frameBytes = (size_t)opts.width * opts.height * 4;
+    gl::GenBuffers(EXPORT_PBO_RING, ex.pbo);
+    for (int i = 0; i < EXPORT_PBO_RING; i++) {
+        gl::BindBuffer(gl::PIXEL_PACK_BUFFER, ex.pbo[i]);
+        gl::BufferData(gl::PIXEL_PACK_BUFFER, frameBytes, nullptr, gl::STREAM_READ);
+    }
+    gl::BindBuffer(gl::PIXEL_PACK_BUFFER, 0);
+
+    for (int i = 0; i < workerCount; i++) ex.workers.emplace_back(WorkerLoop, std::ref(ex));
+    TraceLog(LOG_INFO, "EXPORT: %d frames at %dx%d to %s (%d worker%s)", opts.frames, opts.width, opts.height,
+             opts.path.c_str(), workerCount, workerCount > 1 ? "s" : "");
+    return true;
+}
+
+void CaptureExportFrame(FrameExporter& ex, const RenderTexture2D& src) {
+    int slot = ex.nextSlot;
+    // Ring full: the oldest readback has had EXPORT_PBO_RING frames to finish
+    if (ex.fence[slot]) {
+        SlotReady(ex, slot, true);
+        HandOff(ex, slot);
+    }
+
+    gl::BindFramebuffer(gl::READ_FRAMEBUFFER, src.id);
+    gl::BindBuffer(gl::PIXEL_PACK_BUFFER, ex.pbo[slot]);
+    gl::ReadPixels(0, 0, ex.opts.width, ex.opts.height, gl::RGBA, gl::UNSIGNED_BYTE, nullptr);
+    gl::BindBuffer(gl::PIXEL_PACK_BUFFER, 0);
+    gl::BindFramebuffer(gl::READ_FRAMEBUFFER, 0);
+    ex.fence[slot] = gl::FenceSync(gl::SYNC_GPU_COMMANDS_COMPLETE, 0);
+    ex.slotFrame[slot] = ex.captured++;
+    ex.nextSlot = (slot + 1) % EXPORT_PBO_RING;
+
+    // Hand off everything that has already landed, oldest first
+    for (int i = 0; i < EXPORT_PBO_RING - 1; i++) {
+        int s = (ex.nextSlot + i) % EXPORT_PBO_RING;
+        if (!ex.fence[s] || !SlotReady(ex, s, false)) break;
+        HandOff(ex, s);
+    }
+}
+
+bool FinishExport(FrameExporter& ex) {
+    for (int i = 0; i < EXPORT_PBO_RING; i++) {
+        int s = (ex.nextSlot + i) % EXPORT_PBO_RING;
+        if (!ex.fence[s]) continue;
+        SlotReady(ex, s, true);
+        HandOff(ex, s);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(ex.mutex);
+        ex.stopping = true;
+    }
+    ex.jobReady.notify_all();
+    for (auto& w : ex.workers) w.join();
+    ex.workers.clear();
+
+    // Workers are gone, so the shared state needs no lock from here on
+    if (ex.pipe && pclose(ex.pipe) != 0) {
+        TraceLog(LOG_ERROR, "EXPORT: ffmpeg exited with an error");
+        ex.failed = true;
+    }
+    ex.pipe = nullptr;
+    gl::DeleteBuffers(EXPORT_PBO_RING, ex.pbo);
+
+    TraceLog(LOG_INFO, "EXPORT: Wrote %d frames to %s", ex.written, ex.opts.path.c_str());
+    return !ex.failed;
+}
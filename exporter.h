@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <raylib.h>
+
+#include "gl_ext.h"
+
+// Offline frame export. Each frame is copied into a ring of pixel pack
+// buffers with an asynchronous glReadPixels and fenced; a slot is only
+// mapped once its fence has signalled, so the CPU never waits on a readback
+// that is still in flight. PNG compression (one worker per core) or the
+// raw pipe to ffmpeg (a single ordered writer) runs off the render thread.
+
+struct ExportOptions {
+    bool enabled = false;
+    std::string path;                // Directory for PNGs, or a video file for ffmpeg
+    int width = 3840, height = 2160;
+    int frames = 1800;
+    int fps = 60;
+};
+
+const int EXPORT_PBO_RING = 3;       // Frames in flight between render and map
+const int EXPORT_QUEUE_DEPTH = 8;    // Frames waiting for a worker before the renderer backs off
+
+// True when path names a video container, which is encoded through ffmpeg
+bool IsVideoExportPath(const std::string& path);
+
+struct ExportJob {
+    int frame = 0;
+    std::vector<unsigned char> pixels;   // Top-down RGBA8
+};
+
+// Owns threads and a mutex, so it is set up in place by StartExport
+struct FrameExporter {
+    ExportOptions opts;
+    gl::GLuint pbo[EXPORT_PBO_RING] = {};
+    gl::GLsync fence[EXPORT_PBO_RING] = {};
+    int slotFrame[EXPORT_PBO_RING] = {};
+    int nextSlot = 0;
+    int captured = 0;                // Frames issued to the PBO ring
+    int written = 0;                 // Frames handed to workers
+
+    FILE* pipe = nullptr;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable jobReady, jobDone;
+    std::deque<ExportJob> queue;
+    std::vector<std::vector<unsigned char>> freeBuffers;
+    bool stopping = false;
+    bool failed = false;
+};
+
+bool StartExport(FrameExporter& ex, const ExportOptions& opts);
+
+// Queues a readback of src (which must be opts.width x opts.height) and hands
+// any frames whose readback has completed to the workers
+void CaptureExportFrame(FrameExporter& ex, const RenderTexture2D& src);
+
+// Drains the ring and the workers; false if any frame failed to write
+bool FinishExport(FrameExporter& ex);
@@ -0,0 +1,73 @@
+#include "gl_ext.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace gl {
+#define GL_EXT_DEFINE(ret, name, args) PFN_##name name = nullptr;
+GL_EXT_FUNCTIONS(GL_EXT_DEFINE)
+GL_EXT_COMPUTE_FUNCTIONS(GL_EXT_DEFINE)
+#undef GL_EXT_DEFINE
+}
+
+namespace {
+
+// wglGetProcAddress only knows post-1.1 functions, so the 1.1 core set
+// (glDrawArrays, glEnable, ...) falls back to the opengl32.dll exports.
+// GLX and CGL resolve every core symbol by name.
+void* GetProc(const char* name) {
+#if defined(_WIN32)
+    static HMODULE lib = LoadLibraryA("opengl32.dll");
+    using WglGetProc = PROC (WINAPI*)(LPCSTR);
+    static WglGetProc wglGetProc = lib ? (WglGetProc)(void*)GetProcAddress(lib, "wglGetProcAddress") : nullptr;
+    void* p = wglGetProc ? (void*)wglGetProc(name) : nullptr;
+    // Some drivers report failure with small sentinel values instead of NULL
+    if (p == nullptr || p == (void*)1 || p == (void*)2 || p == (void*)3 || p == (void*)-1)
+        p = lib ? (void*)GetProcAddress(lib, name) : nullptr;
+    return p;
+#elif defined(__APPLE__)
+    static void* lib = dlopen("/System/Library/Frameworks/OpenGL.framework/OpenGL", RTLD_LAZY);
+    return lib ? dlsym(lib, name) : nullptr;
+#else
+    static void* lib = [] {
+        void* h = dlopen("libGL.so.1", RTLD_LAZY);
+        return h ? h : dlopen("libOpenGL.so.0", RTLD_LAZY);
+    }();
+    if (!lib) return nullptr;
+    using GlxGetProc = void* (*)(const unsigned char*);
+    static GlxGetProc glxGetProc = (GlxGetProc)dlsym(lib, "glXGetProcAddressARB");
+    void* p = glxGetProc ? glxGetProc((const unsigned char*)name) : nullptr;
+    return p ? p : dlsym(lib, name);
+#endif
+}
+
+} // namespace
+
+bool gl::LoadExtensions() {
+    bool ok = true;
+#define GL_EXT_LOAD(ret, name, args) \
+    name = (PFN_##name)GetProc("gl" #name); \
+    ok = ok && name != nullptr;
+    GL_EXT_FUNCTIONS(GL_EXT_LOAD)
+#undef GL_EXT_LOAD
+    return ok;
+}
+
+bool gl::LoadComputeExtensions() {
+    // A driver may export the symbols for a context that can't run them
+    GLint major = 0, minor = 0;
+    GetIntegerv(MAJOR_VERSION, &major);
+    GetIntegerv(MINOR_VERSION, &minor);
+    if (major < 4 || (major == 4 && minor < 3)) return false;
+    bool ok = true;
+#define GL_EXT_LOAD(ret, name, args) \
+    name = (PFN_##name)GetProc("gl" #name); \
+    ok = ok && name != nullptr;
+    GL_EXT_COMPUTE_FUNCTIONS(GL_EXT_LOAD)
+#undef GL_EXT_LOAD
+    return ok;
+}
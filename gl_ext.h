@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstddef>
+
+// Thin OpenGL 3.3 entry-point table for the few calls rlgl does not wrap
+// (line/point draws from our own VBOs, vertex attribute setup, uniform blocks,
+// instanced multi-view draws, compute programs).
+// Resolved at runtime from the driver of the context raylib creates, so
+// LoadExtensions() must be called after InitWindow(). The GL 4.3 compute
+// entry points are optional and resolved separately by LoadComputeExtensions().
+
+#if defined(_WIN32) && !defined(_WIN64)
+#define GL_EXT_APIENTRY __stdcall
+#else
+#define GL_EXT_APIENTRY
+#endif
+
+namespace gl {
+
+using GLenum = unsigned int;
+using GLuint = unsigned int;
+using GLint = int;
+using GLsizei = int;
+using GLboolean = unsigned char;
+using GLfloat = float;
+using GLbitfield = unsigned int;
+using GLsizeiptr = std::ptrdiff_t;
+using GLintptr = std::ptrdiff_t;
+using GLuint64 = unsigned long long;
+using GLsync = struct GLsyncObject *;
+
+constexpr GLenum POINTS = 0x0000;
+constexpr GLenum LINES = 0x0001;
+constexpr GLenum TRIANGLES = 0x0004;
+constexpr GLenum UNSIGNED_BYTE = 0x1401;
+constexpr GLenum SHORT = 0x1402;
+constexpr GLenum UNSIGNED_INT = 0x1405;
+constexpr GLenum FLOAT = 0x1406;
+constexpr GLenum ARRAY_BUFFER = 0x8892;
+constexpr GLenum STREAM_DRAW = 0x88E0;
+constexpr GLenum STATIC_DRAW = 0x88E4;
+constexpr GLenum DYNAMIC_DRAW = 0x88E8;
+constexpr GLenum TEXTURE0 = 0x84C0;
+constexpr GLenum TEXTURE_2D = 0x0DE1;
+constexpr GLenum PROGRAM_POINT_SIZE = 0x8642;
+constexpr GLenum BLEND = 0x0BE2;
+constexpr GLenum DEPTH_TEST = 0x0B71;
+constexpr GLenum VIEWPORT = 0x0BA2;
+constexpr GLenum COLOR_BUFFER_BIT = 0x4000;
+constexpr GLenum RGBA = 0x1908;
+constexpr GLenum RGBA8 = 0x8058;
+constexpr GLenum TEXTURE_CUBE_MAP = 0x8513;
+constexpr GLenum TEXTURE_CUBE_MAP_POSITIVE_X = 0x8515;
+constexpr GLenum TEXTURE_MAG_FILTER = 0x2800;
+constexpr GLenum TEXTURE_MIN_FILTER = 0x2801;
+constexpr GLenum TEXTURE_WRAP_S = 0x2802;
+constexpr GLenum TEXTURE_WRAP_T = 0x2803;
+constexpr GLenum TEXTURE_WRAP_R = 0x8072;
+constexpr GLenum LINEAR = 0x2601;
+constexpr GLenum CLAMP_TO_EDGE = 0x812F;
+constexpr GLenum FRAMEBUFFER = 0x8D40;
+constexpr GLenum FRAMEBUFFER_BINDING = 0x8CA6;
+constexpr GLenum FRAMEBUFFER_COMPLETE = 0x8CD5;
+constexpr GLenum COLOR_ATTACHMENT0 = 0x8CE0;
+constexpr GLenum COLOR_ATTACHMENT1 = 0x8CE1;
+constexpr GLenum TIME_ELAPSED = 0x88BF;
+constexpr GLenum QUERY_RESULT = 0x8866;
+constexpr GLenum QUERY_RESULT_AVAILABLE = 0x8867;
+constexpr GLenum RENDERER = 0x1F01;
+constexpr GLenum VERSION = 0x1F02;
+constexpr GLenum PIXEL_PACK_BUFFER = 0x88EB;
+constexpr GLenum STREAM_READ = 0x88E1;
+constexpr GLbitfield MAP_READ_BIT = 0x0001;
+constexpr GLenum READ_FRAMEBUFFER = 0x8CA8;
+constexpr GLenum SYNC_GPU_COMMANDS_COMPLETE = 0x9117;
+constexpr GLbitfield SYNC_FLUSH_COMMANDS_BIT = 0x0001;
+constexpr GLenum ALREADY_SIGNALED = 0x911A;
+constexpr GLenum CONDITION_SATISFIED = 0x911C;
+constexpr GLenum HALF_FLOAT = 0x140B;
+constexpr GLenum RGBA16F = 0x881A;
+constexpr GLenum RED_FORMAT = 0x1903;  // GL_RED, renamed: raylib.h defines RED as a color
+constexpr GLenum R16F = 0x822D;
+constexpr GLenum DEPTH_COMPONENT24 = 0x81A6;
+constexpr GLenum DEPTH_ATTACHMENT = 0x8D00;
+constexpr GLenum RENDERBUFFER = 0x8D41;
+constexpr GLenum DRAW_FRAMEBUFFER = 0x8CA9;
+constexpr GLenum MAX_SAMPLES = 0x8D57;
+constexpr GLenum NEAREST = 0x2600;
+constexpr GLenum UNIFORM_BUFFER = 0x8A11;
+constexpr GLuint INVALID_INDEX = 0xFFFFFFFFu;
+constexpr GLenum CLIP_DISTANCE0 = 0x3000;
+constexpr GLenum CLIP_DISTANCE1 = 0x3001;
+constexpr GLenum MAJOR_VERSION = 0x821B;
+constexpr GLenum MINOR_VERSION = 0x821C;
+constexpr GLenum COMPUTE_SHADER = 0x91B9;
+constexpr GLenum COMPILE_STATUS = 0x8B81;
+constexpr GLenum LINK_STATUS = 0x8B82;
+constexpr GLenum SHADER_STORAGE_BUFFER = 0x90D2;
+constexpr GLbitfield VERTEX_ATTRIB_ARRAY_BARRIER_BIT = 0x0001;
+constexpr GLbitfield SHADER_STORAGE_BARRIER_BIT = 0x2000;
+
+// X(return type, name without the "gl" prefix, parameter list)
+#define GL_EXT_FUNCTIONS(X) \
+    X(void, GenVertexArrays, (GLsizei n, GLuint *arrays)) \
+    X(void, BindVertexArray, (GLuint array)) \
+    X(void, DeleteVertexArrays, (GLsizei n, const GLuint *arrays)) \
+    X(void, GenBuffers, (GLsizei n, GLuint *buffers)) \
+    X(void, BindBuffer, (GLenum target, GLuint buffer)) \
+    X(void, BufferData, (GLenum target, GLsizeiptr size, const void *data, GLenum usage)) \
+    X(void, BufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void *data)) \
+    X(void, DeleteBuffers, (GLsizei n, const GLuint *buffers)) \
+    X(void, VertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer)) \
+    X(void, VertexAttribIPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer)) \
+    X(void, EnableVertexAttribArray, (GLuint index)) \
+    X(void, DrawArrays, (GLenum mode, GLint first, GLsizei count)) \
+    X(void, DrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount)) \
+    X(void, Enable, (GLenum cap)) \
+    X(void, Disable, (GLenum cap)) \
+    X(void, ActiveTexture, (GLenum texture)) \
+    X(void, BindTexture, (GLenum target, GLuint texture)) \
+    X(void, GenTextures, (GLsizei n, GLuint *textures)) \
+    X(void, DeleteTextures, (GLsizei n, const GLuint *textures)) \
+    X(void, TexImage2D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels)) \
+    X(void, TexParameteri, (GLenum target, GLenum pname, GLint param)) \
+    X(void, GenFramebuffers, (GLsizei n, GLuint *framebuffers)) \
+    X(void, DeleteFramebuffers, (GLsizei n, const GLuint *framebuffers)) \
+    X(void, BindFramebuffer, (GLenum target, GLuint framebuffer)) \
+    X(void, FramebufferTexture2D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)) \
+    X(void, DrawBuffers, (GLsizei n, const GLenum *bufs)) \
+    X(GLenum, CheckFramebufferStatus, (GLenum target)) \
+    X(void, Viewport, (GLint x, GLint y, GLsizei width, GLsizei height)) \
+    X(void, ClearColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)) \
+    X(void, Clear, (GLbitfield mask)) \
+    X(void, GetIntegerv, (GLenum pname, GLint *data)) \
+    X(void, GenQueries, (GLsizei n, GLuint *ids)) \
+    X(void, DeleteQueries, (GLsizei n, const GLuint *ids)) \
+    X(void, BeginQuery, (GLenum target, GLuint id)) \
+    X(void, EndQuery, (GLenum target)) \
+    X(void, GetQueryObjectiv, (GLuint id, GLenum pname, GLint *params)) \
+    X(void, GetQueryObjectui64v, (GLuint id, GLenum pname, GLuint64 *params)) \
+    X(const unsigned char *, GetString, (GLenum name)) \
+    X(void, ReadPixels, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels)) \
+    X(void *, MapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+    X(GLboolean, UnmapBuffer, (GLenum target)) \
+    X(GLsync, FenceSync, (GLenum condition, GLbitfield flags)) \
+    X(GLenum, ClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    X(void, DeleteSync, (GLsync sync)) \
+    X(void, GenRenderbuffers, (GLsizei n, GLuint *renderbuffers)) \
+    X(void, DeleteRenderbuffers, (GLsizei n, const GLuint *renderbuffers)) \
+    X(void, BindRenderbuffer, (GLenum target, GLuint renderbuffer)) \
+    X(void, RenderbufferStorageMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)) \
+    X(void, FramebufferRenderbuffer, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)) \
+    X(void, BlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)) \
+    X(void, BindBufferBase, (GLenum target, GLuint index, GLuint buffer)) \
+    X(GLuint, GetUniformBlockIndex, (GLuint program, const char *uniformBlockName)) \
+    X(void, UniformBlockBinding, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)) \
+    X(void, UniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)) \
+    X(GLuint, CreateShader, (GLenum type)) \
+    X(void, ShaderSource, (GLuint shader, GLsizei count, const char *const *string, const GLint *length)) \
+    X(void, CompileShader, (GLuint shader)) \
+    X(void, GetShaderiv, (GLuint shader, GLenum pname, GLint *params)) \
+    X(void, GetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei *length, char *infoLog)) \
+    X(void, DeleteShader, (GLuint shader)) \
+    X(GLuint, CreateProgram, (void)) \
+    X(void, AttachShader, (GLuint program, GLuint shader)) \
+    X(void, LinkProgram, (GLuint program)) \
+    X(void, GetProgramiv, (GLuint program, GLenum pname, GLint *params)) \
+    X(void, GetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei *length, char *infoLog)) \
+    X(void, DeleteProgram, (GLuint program)) \
+    X(void, UseProgram, (GLuint program)) \
+    X(GLint, GetUniformLocation, (GLuint program, const char *name)) \
+    X(void, Uniform1i, (GLint location, GLint v0)) \
+    X(void, Uniform1ui, (GLint location, GLuint v0)) \
+    X(void, Uniform1f, (GLint location, GLfloat v0))
+
+// GL 4.3 (or ARB_compute_shader); absent from a 3.3 context
+#define GL_EXT_COMPUTE_FUNCTIONS(X) \
+    X(void, DispatchCompute, (GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)) \
+    X(void, MemoryBarrier, (GLbitfield barriers))
+
+#define GL_EXT_DECLARE(ret, name, args) \
+    using PFN_##name = ret (GL_EXT_APIENTRY *) args; \
+    extern PFN_##name name;
+GL_EXT_FUNCTIONS(GL_EXT_DECLARE)
+GL_EXT_COMPUTE_FUNCTIONS(GL_EXT_DECLARE)
+#undef GL_EXT_DECLARE
+
+// Returns false if any entry point could not be resolved
+bool LoadExtensions();
+// Returns false unless the context is GL 4.3+ and every compute entry point resolved
+bool LoadComputeExtensions();
+
+} // namespace gl
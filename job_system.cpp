@@ -0,0 +1,176 @@
+#include "job_system.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <raylib.h>
+
+namespace {
+
+// Index of the worker running on this thread, -1 on threads outside the pool
+thread_local int tlsWorker = -1;
+
+bool PopJob(JobQueue& q, Job& job, bool newest) {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.jobs.empty()) return false;
+    if (newest) {
+        job = std::move(q.jobs.back());
+        q.jobs.pop_back();
+    } else {
+        job = std::move(q.jobs.front());
+        q.jobs.pop_front();
+    }
+    return true;
+}
+
+// Oldest background job of `group`, wherever it sits in the queue
+bool PopGroupJob(JobQueue& q, const JobGroup& group, Job& job) {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    auto it = std::find_if(q.jobs.begin(), q.jobs.end(), [&group](const Job& j) { return j.group == &group; });
+    if (it == q.jobs.end()) return false;
+    job = std::move(*it);
+    q.jobs.erase(it);
+    return true;
+}
+
+// Own queue first (newest job, still warm in cache), then steal the oldest
+// elsewhere; the background queue only when `background` is set
+bool TakeJob(JobSystem& js, int self, Job& job, bool background) {
+    int n = (int)js.queues.size();
+    int start = self >= 0 ? self : 0;
+    if (self >= 0 && PopJob(*js.queues[self], job, true)) {
+        js.queued--;
+        return true;
+    }
+    for (int i = 0; i < n; i++) {
+        int victim = (start + i + (self >= 0)) % n;
+        if (PopJob(*js.queues[victim], job, false)) {
+            js.queued--;
+            return true;
+        }
+    }
+    if (background && PopJob(js.background, job, false)) {
+        js.queued--;
+        return true;
+    }
+    return false;
+}
+
+void RunJob(Job& job) {
+    job.fn();
+    job.group->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void WorkerLoop(JobSystem& js, int self) {
+    tlsWorker = self;
+    for (;;) {
+        Job job;
+        if (TakeJob(js, self, job, true)) {
+            RunJob(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(js.sleepMutex);
+        js.wake.wait(lock, [&] { return js.stopping || js.queued > 0; });
+        if (js.stopping && js.queued <= 0) return;
+    }
+}
+
+// Workers push to their own queue; everyone else spreads jobs round-robin
+JobQueue& SubmitQueue(JobSystem& js) {
+    if (tlsWorker >= 0) return *js.queues[tlsWorker];
+    return *js.queues[js.nextQueue++ % js.queues.size()];
+}
+
+// Counted after the push so a worker never sees work that isn't there yet
+void Publish(JobSystem& js, int count) {
+    {
+        std::lock_guard<std::mutex> lock(js.sleepMutex);
+        js.queued += count;
+    }
+    if (count > 1) js.wake.notify_all();
+    else js.wake.notify_one();
+}
+
+// ParallelFor's chunks, on the worker queues or the background queue
+void QueueChunks(JobSystem& js, JobGroup& group, int count, int grain, const std::function<void(int, int)>& fn,
+                 bool background) {
+    grain = std::max(1, grain);
+    int chunks = (count + grain - 1) / grain;
+    if (chunks <= 0) return;
+    group.pending.fetch_add(chunks, std::memory_order_relaxed);
+    for (int c = 0; c < chunks; c++) {
+        int begin = c * grain, end = std::min(count, begin + grain);
+        JobQueue& q = background ? js.background : SubmitQueue(js);
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.jobs.push_back({[fn, begin, end] { fn(begin, end); }, &group});
+    }
+    Publish(js, chunks);
+}
+
+} // namespace
+
+void StartJobSystem(JobSystem& js, int workerCount) {
+    if (workerCount <= 0) workerCount = (int)std::thread::hardware_concurrency() - 1;
+    workerCount = std::max(0, workerCount);
+
+    // With no workers the waiting thread runs everything from queue 0
+    for (int i = 0; i < std::max(1, workerCount); i++) js.queues.push_back(std::make_unique<JobQueue>());
+    for (int i = 0; i < workerCount; i++) js.workers.emplace_back(WorkerLoop, std::ref(js), i);
+    TraceLog(LOG_INFO, "JOBS: %d worker thread%s", workerCount, workerCount == 1 ? "" : "s");
+}
+
+void StopJobSystem(JobSystem& js) {
+    {
+        std::lock_guard<std::mutex> lock(js.sleepMutex);
+        js.stopping = true;
+    }
+    js.wake.notify_all();
+    for (auto& w : js.workers) w.join();
+    js.workers.clear();
+
+    // Nothing left to run them when there were no workers
+    Job job;
+    while (TakeJob(js, -1, job, true)) RunJob(job);
+    js.queues.clear();
+}
+
+void SubmitJob(JobSystem& js, JobGroup& group, std::function<void()> fn) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+    JobQueue& q = SubmitQueue(js);
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.jobs.push_back({std::move(fn), &group});
+    }
+    Publish(js, 1);
+}
+
+void ParallelFor(JobSystem& js, JobGroup& group, int count, int grain, const std::function<void(int, int)>& fn) {
+    QueueChunks(js, group, count, grain, fn, false);
+}
+
+void ParallelForBackground(JobSystem& js, JobGroup& group, int count, int grain, const std::function<void(int, int)>& fn) {
+    QueueChunks(js, group, count, grain, fn, true);
+}
+
+void WaitJobGroup(JobSystem& js, JobGroup& group) {
+    while (!IsJobGroupDone(group)) {
+        Job job;
+        if (TakeJob(js, tlsWorker, job, false)) {
+            RunJob(job);
+        } else if (PopGroupJob(js.background, group, job)) {
+            js.queued--;
+            RunJob(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void RunBackgroundJobs(JobSystem& js, double seconds) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    Job job;
+    while (std::chrono::steady_clock::now() < deadline && PopJob(js.background, job, false)) {
+        js.queued--;
+        RunJob(job);
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small work-stealing thread pool. Every worker owns a deque and takes the
+// newest job from its own back; when that runs dry it steals the oldest job
+// from another worker's front. A thread waiting on a group runs queued jobs
+// itself instead of blocking, so the main thread is never an idle core.
+//
+// Long-running work that no frame waits on goes to a shared background queue.
+// Workers only turn to it once every worker queue is empty, and a waiting
+// thread only runs background jobs of the group it waits on, so a frame never
+// picks up someone else's multi-millisecond job while it waits on its own.
+
+// Completion counter for a batch of jobs
+struct JobGroup {
+    std::atomic<int> pending{0};
+};
+
+struct Job {
+    std::function<void()> fn;
+    JobGroup* group = nullptr;
+};
+
+struct JobQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+};
+
+// Owns threads and mutexes, so it is set up in place by StartJobSystem
+struct JobSystem {
+    std::vector<std::unique_ptr<JobQueue>> queues;   // One per worker (at least one)
+    JobQueue background;                             // Low priority, oldest first
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queued{0};
+    std::atomic<unsigned> nextQueue{0};              // Round-robin target for outside submitters
+    bool stopping = false;                           // Guarded by sleepMutex
+};
+
+// workerCount 0 picks one worker per core, minus the calling thread
+void StartJobSystem(JobSystem& js, int workerCount = 0);
+
+// Lets queued jobs finish, then joins the workers
+void StopJobSystem(JobSystem& js);
+
+void SubmitJob(JobSystem& js, JobGroup& group, std::function<void()> fn);
+
+// Splits [0, count) into chunks of `grain` and queues fn(begin, end) for each
+void ParallelFor(JobSystem& js, JobGroup& group, int count, int grain, const std::function<void(int, int)>& fn);
+
+// ParallelFor on the background queue
+void ParallelForBackground(JobSystem& js, JobGroup& group, int count, int grain, const std::function<void(int, int)>& fn);
+
+// Runs queued jobs on the calling thread until every job in the group is done;
+// of the background jobs it only runs the group's own
+void WaitJobGroup(JobSystem& js, JobGroup& group);
+
+// Runs background jobs on the calling thread until `seconds` have passed (a
+// job that starts in time runs to the end) or there are none left. Background
+// work only advances this way without workers.
+void RunBackgroundJobs(JobSystem& js, double seconds);
+
+inline bool IsJobGroupDone(const JobGroup& group) { return group.pending.load(std::memory_order_acquire) == 0; }
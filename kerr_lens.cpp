@@ -0,0 +1,288 @@
+#include "kerr_lens.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace {
+
+// Geodesics are integrated in units of M (Rs = 2), Boyer-Lindquist coordinates
+// with world +y as the spin axis.
+const double R_OBSERVER = 100.0;   // Rays start and end here; the bend outside is < 0.5% for b <= 12 Rs
+const double STEP = 0.05;          // Affine step as a fraction of r; RK4 holds the table to 4 digits
+const double HORIZON_MARGIN = 0.01;
+const int MAX_STEPS = 20000;       // Still winding the photon orbit: treat as captured
+const int ROW_GRAIN = 1;           // One row per job (a few ms), on the background queue
+const double SOLO_FRAME_BUDGET = 0.008;  // Seconds of tracing per frame on the main thread without workers
+
+struct Vec3d {
+    double x, y, z;
+};
+
+Vec3d operator+(Vec3d a, Vec3d b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+Vec3d operator*(Vec3d a, double s) { return {a.x * s, a.y * s, a.z * s}; }
+double Dot(Vec3d a, Vec3d b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+// Position and covariant momenta of a photon with E = 1 and p_φ = L
+struct PhotonState {
+    double r, theta, phi, pr, ptheta;
+};
+
+PhotonState operator+(const PhotonState& a, const PhotonState& b) {
+    return {a.r + b.r, a.theta + b.theta, a.phi + b.phi, a.pr + b.pr, a.ptheta + b.ptheta};
+}
+PhotonState operator*(const PhotonState& a, double s) {
+    return {a.r * s, a.theta * s, a.phi * s, a.pr * s, a.ptheta * s};
+}
+
+// Hamilton's equations for the Kerr null geodesic,
+//   2ΣH = Δ·p_r² + p_θ² - W²/Δ + V²/sin²θ,  W = r² + a² - aL,  V = L - a·sin²θ
+// (Carter's separable form; H = 0 on the light cone)
+PhotonState Derivatives(const PhotonState& s, double a, double L) {
+    double sn = sin(s.theta), cs = cos(s.theta);
+    double s2 = std::max(sn * sn, 1e-10);
+    double r2 = s.r * s.r;
+    double sigma = r2 + a * a * cs * cs;
+    double delta = r2 - 2.0 * s.r + a * a;
+    double w = r2 + a * a - a * L;
+    double v = L - a * s2;
+
+    double n = delta * s.pr * s.pr + s.ptheta * s.ptheta - w * w / delta + v * v / s2;
+    double dDelta = 2.0 * s.r - 2.0;
+    double dNdr = dDelta * s.pr * s.pr - (4.0 * s.r * w * delta - w * w * dDelta) / (delta * delta);
+    double dS2 = 2.0 * sn * cs;
+    double dNdtheta = -dS2 * v * (2.0 * a * s2 + v) / (s2 * s2);
+
+    PhotonState d;
+    d.r = delta * s.pr / sigma;
+    d.theta = s.ptheta / sigma;
+    d.phi = (a * w / delta + v / s2) / sigma;
+    d.pr = -(dNdr - n * 2.0 * s.r / sigma) / (2.0 * sigma);
+    d.ptheta = -(dNdtheta + n * 2.0 * a * a * sn * cs / sigma) / (2.0 * sigma);
+    return d;
+}
+
+// The traced ray runs from the observer into the scene, i.e. the physical
+// photon backwards in λ
+PhotonState Backwards(const PhotonState& s, double a, double L) {
+    return Derivatives(s, a, L) * -1.0;
+}
+
+// ν_obs / ν_emit for gas on a prograde circular equatorial orbit at r (Bardeen 1972)
+double DiskRedshift(double r, double a, double L) {
+    double r15 = r * sqrt(r);
+    double omega = 1.0 / (r15 + a);
+    double ut = (r15 + a) / (sqrt(sqrt(r) * r) * sqrt(r15 - 3.0 * sqrt(r) + 2.0 * a));
+    return 1.0 / (ut * (1.0 - omega * L));
+}
+
+// World-space direction of motion from coordinate velocities
+Vec3d ToCartesian(const PhotonState& s, const PhotonState& d) {
+    double sn = sin(s.theta), cs = cos(s.theta), sp = sin(s.phi), cp = cos(s.phi);
+    Vec3d rHat = {sn * cp, cs, sn * sp};
+    Vec3d thetaHat = {cs * cp, -sn, cs * sp};
+    Vec3d phiHat = {-sp, 0.0, cp};
+    Vec3d v = rHat * d.r + thetaHat * (s.r * d.theta) + phiHat * (s.r * sn * d.phi);
+    return v * (1.0 / sqrt(Dot(v, v)));
+}
+
+void TraceRows(float spin, float inclination, float diskOuter, int begin, int end, float* out) {
+    for (int j = begin; j < end; j++) {
+        float y = ((j + 0.5f) / KERR_MAP_SIZE * 2.0f - 1.0f) * KERR_MAP_EXTENT;
+        for (int i = 0; i < KERR_MAP_SIZE; i++) {
+            float x = ((i + 0.5f) / KERR_MAP_SIZE * 2.0f - 1.0f) * KERR_MAP_EXTENT;
+            KerrRay ray = TraceKerrRay(spin, inclination, x, y, diskOuter);
+            float* t = out + (j * KERR_MAP_SIZE + i) * 4;
+            t[0] = ray.bendX;
+            t[1] = ray.bendY;
+            t[2] = ray.escaped ? 1.0f : 0.0f;
+            t[3] = ray.redshift;
+        }
+    }
+}
+
+const int SLICE_FLOATS = KERR_MAP_SIZE * KERR_MAP_SIZE * 4;
+const AssetDesc MAP_DESC = {PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, KERR_MAP_SIZE, KERR_MAP_SIZE * KERR_MAP_SLICES};
+
+// Everything the texels depend on; bump the version when the tracer changes
+std::string GetMapKey(float spin, float diskOuter) {
+    return TextFormat("kerr v1 a=%.4f outer=%.3f %dx%d/%d extent=%.2f incl=%.3f step=%.3f", spin, diskOuter,
+                      KERR_MAP_SIZE, KERR_MAP_SIZE, KERR_MAP_SLICES, KERR_MAP_EXTENT, KERR_INCLINATION_MIN, STEP);
+}
+
+void StartBuild(KerrLensMap& map, JobSystem& jobs, float spin) {
+    map.building = true;
+    map.buildSpin = spin;
+    float diskOuter = map.diskOuter;
+    for (int s = 0; s < KERR_MAP_SLICES; s++) {
+        map.uploaded[s] = false;
+        float* out = map.staging.data() + s * SLICE_FLOATS;
+        float inclination = GetKerrSliceInclination(s);
+        ParallelForBackground(jobs, map.groups[s], KERR_MAP_SIZE, ROW_GRAIN, [=](int begin, int end) {
+            TraceRows(spin, inclination, diskOuter, begin, end, out);
+        });
+    }
+}
+
+} // namespace
+
+KerrRay TraceKerrRay(float spin, float inclination, float x, float y, float diskOuter) {
+    double a = std::clamp((double)spin, 0.0, (double)KERR_SPIN_MAX);
+    double si = sin(inclination), ci = cos(inclination);
+
+    // Observer in the x-y plane looking at the hole; screen right is -z and
+    // screen up the projection of the spin axis
+    Vec3d n = {si, ci, 0.0}, right = {0.0, 0.0, -1.0}, up = {-ci, si, 0.0};
+    Vec3d p = n * R_OBSERVER + right * (2.0 * x) + up * (2.0 * y);
+    Vec3d view = n * -1.0;
+
+    // Far from the hole Boyer-Lindquist coordinates are spherical, so the
+    // arriving photon's constants come straight from its direction -view
+    PhotonState s;
+    s.r = sqrt(Dot(p, p));
+    s.theta = acos(p.y / s.r);
+    s.phi = atan2(p.z, p.x);
+    double sn = sin(s.theta), cs = cos(s.theta), sp = sin(s.phi), cp = cos(s.phi);
+    Vec3d thetaHat = {cs * cp, -sn, cs * sp};
+    Vec3d phiHat = {-sp, 0.0, cp};
+    double L = -s.r * sn * Dot(view, phiHat);
+    double sigma = s.r * s.r + a * a * cs * cs;
+    double delta = s.r * s.r - 2.0 * s.r + a * a;
+    s.ptheta = -sigma * Dot(view, thetaHat) / s.r;
+    // p_r from H = 0, outgoing at the observer
+    double w = s.r * s.r + a * a - a * L, v = L - a * sn * sn;
+    double pr2 = (w * w / delta - v * v / (sn * sn) - s.ptheta * s.ptheta) / delta;
+    s.pr = sqrt(std::max(pr2, 0.0));
+
+    KerrRay ray = {0.0f, 0.0f, false, 1.0f};
+    double horizon = 1.0 + sqrt(1.0 - a * a) + HORIZON_MARGIN;
+    double isco = 2.0 * GetKerrIsco((float)a), outer = 2.0 * diskOuter;
+    bool crossed = false;
+    for (int step = 0; step < MAX_STEPS; step++) {
+        if (s.r < horizon) return ray;
+
+        // RK4 along the traced ray
+        double h = STEP * s.r;
+        PhotonState k1 = Backwards(s, a, L);
+        PhotonState k2 = Backwards(s + k1 * (0.5 * h), a, L);
+        PhotonState k3 = Backwards(s + k2 * (0.5 * h), a, L);
+        PhotonState k4 = Backwards(s + k3 * h, a, L);
+        PhotonState next = s + (k1 + k2 * 2.0 + k3 * 2.0 + k4) * (h / 6.0);
+
+        // First pass through the equatorial plane inside the disk
+        double c0 = cos(s.theta), c1 = cos(next.theta);
+        if (!crossed && c0 * c1 <= 0.0 && c0 != c1) {
+            double rc = s.r + c0 / (c0 - c1) * (next.r - s.r);
+            if (rc >= isco && rc <= outer) {
+                ray.redshift = (float)DiskRedshift(rc, a, L);
+                crossed = true;
+            }
+        }
+        s = next;
+
+        PhotonState d = Backwards(s, a, L);
+        if (s.r > R_OBSERVER && d.r > 0.0) {
+            Vec3d dir = ToCartesian(s, d);
+            double bend = acos(std::clamp(Dot(dir, view), -1.0, 1.0));
+            double bx = Dot(dir, right), by = Dot(dir, up);
+            double len = sqrt(bx * bx + by * by);
+            if (len > 1e-12) {
+                ray.bendX = (float)(bend * bx / len);
+                ray.bendY = (float)(bend * by / len);
+            }
+            ray.escaped = true;
+            return ray;
+        }
+    }
+    return ray;
+}
+
+float GetKerrIsco(float spin) {
+    double a = std::clamp((double)spin, 0.0, 1.0);
+    double z1 = 1.0 + cbrt(1.0 - a * a) * (cbrt(1.0 + a) + cbrt(1.0 - a));
+    double z2 = sqrt(3.0 * a * a + z1 * z1);
+    return (float)(0.5 * (3.0 + z2 - sqrt((3.0 - z1) * (3.0 + z1 + 2.0 * z2))));
+}
+
+float GetKerrSliceInclination(int index) {
+    return KERR_INCLINATION_MIN + (0.5f * PI - KERR_INCLINATION_MIN) * index / (KERR_MAP_SLICES - 1);
+}
+
+float GetKerrSliceCoord(float inclination) {
+    float s = (inclination - KERR_INCLINATION_MIN) / (0.5f * PI - KERR_INCLINATION_MIN) * (KERR_MAP_SLICES - 1);
+    return std::clamp(s, 0.0f, (float)(KERR_MAP_SLICES - 1));
+}
+
+void LoadKerrLensMap(KerrLensMap& map, JobSystem& jobs, const AssetCache& cache, float spin, float diskOuter) {
+    map.diskOuter = diskOuter;
+    map.cache = &cache;
+    map.staging.assign(SLICE_FLOATS * KERR_MAP_SLICES, 0.0f);
+    double start = GetTime();
+    std::string key = GetMapKey(spin, diskOuter);
+    CachedAsset cached;
+    bool hit = LoadCachedAsset(cache, "kerr", key, MAP_DESC, cached);
+    if (!hit) {
+        StartBuild(map, jobs, spin);
+        for (int s = 0; s < KERR_MAP_SLICES; s++) WaitJobGroup(jobs, map.groups[s]);
+        SaveCachedAsset(cache, "kerr", key, MAP_DESC, map.staging.data());
+    }
+
+    Image img = {hit ? (void*)cached.data : map.staging.data(), KERR_MAP_SIZE, KERR_MAP_SIZE * KERR_MAP_SLICES, 1,
+                 PIXELFORMAT_UNCOMPRESSED_R32G32B32A32};
+    map.texture = LoadTextureFromImage(img);
+    UnloadCachedAsset(cached);
+    SetTextureFilter(map.texture, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(map.texture, TEXTURE_WRAP_CLAMP);
+    map.building = false;
+    map.spin = map.requestedSpin = spin;
+    TraceLog(LOG_INFO, "KERR: %d %dx%d map slices for spin %.3f %s in %.0f ms", KERR_MAP_SLICES, KERR_MAP_SIZE,
+             KERR_MAP_SIZE, spin, hit ? "loaded" : "traced", (GetTime() - start) * 1000.0);
+}
+
+void UnloadKerrLensMap(KerrLensMap& map, JobSystem& jobs) {
+    for (int s = 0; s < KERR_MAP_SLICES; s++) WaitJobGroup(jobs, map.groups[s]);
+    UnloadTexture(map.texture);
+    map.texture = {0};
+    map.staging.clear();
+    map.building = false;
+}
+
+void RequestKerrLensMap(KerrLensMap& map, float spin) {
+    map.requestedSpin = std::clamp(spin, 0.0f, KERR_SPIN_MAX);
+}
+
+bool UpdateKerrLensMap(KerrLensMap& map, JobSystem& jobs) {
+    if (!map.building) {
+        if (map.requestedSpin == map.spin) return false;
+        CachedAsset cached;
+        if (map.cache && LoadCachedAsset(*map.cache, "kerr", GetMapKey(map.requestedSpin, map.diskOuter), MAP_DESC, cached)) {
+            UpdateTexture(map.texture, cached.data);
+            UnloadCachedAsset(cached);
+            map.spin = map.requestedSpin;
+            return true;
+        }
+        StartBuild(map, jobs, map.requestedSpin);
+        return false;
+    }
+    // Single core: nothing picks the rows up unless someone waits, so the
+    // frame traces for a fixed slice of its time
+    if (jobs.workers.empty()) RunBackgroundJobs(jobs, SOLO_FRAME_BUDGET);
+
+    bool done = true;
+    for (int s = 0; s < KERR_MAP_SLICES; s++) {
+        if (map.uploaded[s]) continue;
+        if (!IsJobGroupDone(map.groups[s])) {
+            done = false;
+            continue;
+        }
+        Rectangle rows = {0, (float)(s * KERR_MAP_SIZE), (float)KERR_MAP_SIZE, (float)KERR_MAP_SIZE};
+        UpdateTextureRec(map.texture, rows, map.staging.data() + s * SLICE_FLOATS);
+        map.uploaded[s] = true;
+    }
+    if (!done) return false;
+    map.building = false;
+    map.spin = map.buildSpin;
+    TraceLog(LOG_INFO, "KERR: Rebuilt map for spin %.3f", map.spin);
+    if (map.cache) SaveCachedAsset(*map.cache, "kerr", GetMapKey(map.spin, map.diskOuter), MAP_DESC, map.staging.data());
+    return true;
+}
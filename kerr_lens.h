@@ -0,0 +1,72 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <vector>
+
+#include "asset_cache.h"
+#include "job_system.h"
+
+// Kerr lens model (lensModel 2). Kerr null geodesics are traced backwards from
+// a distant observer over the image plane, once per inclination slice, and
+// the result is uploaded as an RGBA32F texture for lensing.fs:
+//   rg: bend of the ray on screen (radians, right/up), zero if captured
+//   b:  1 where the ray escapes, 0 where it falls into the hole (the shadow)
+//   a:  redshift g = ν_obs / ν_emit of the first disk crossing, 1 if none
+// Slices cover KERR_INCLINATION_MIN to the equator and are stacked bottom to
+// top; views from below the disk plane mirror the upper half.
+//
+// Lengths are in Rs like the rest of the scene (M = Rs / 2); spin is a / M.
+// Every completed map is saved to the asset cache, so spins seen before (and
+// the startup spin on every launch after the first) load without tracing.
+
+const int KERR_MAP_SIZE = 128;             // Texels per side of one slice
+const int KERR_MAP_SLICES = 8;
+const float KERR_MAP_EXTENT = 12.0f;       // Slice half-width in Rs; weak field beyond
+const float KERR_INCLINATION_MIN = 0.35f;  // Radians from the spin axis (~20°)
+const float KERR_SPIN_MAX = 0.998f;        // Thorne limit
+
+struct KerrRay {
+    float bendX, bendY;
+    bool escaped;
+    float redshift;
+};
+
+// One ray for image-plane offset (x right, y up, in Rs) seen from `inclination`
+// radians off the spin axis; disk crossings count between the ISCO and diskOuter
+KerrRay TraceKerrRay(float spin, float inclination, float x, float y, float diskOuter);
+
+// Prograde ISCO radius in Rs: 3 at spin 0, 0.5 at spin 1
+float GetKerrIsco(float spin);
+
+struct KerrLensMap {
+    Texture2D texture = {0};
+    float spin = 0.0f;                     // Spin of the complete map on the GPU
+    float diskOuter = 0.0f;
+    const AssetCache* cache = nullptr;
+
+    // Rebuild in flight: slices are traced into `staging` and uploaded one by
+    // one as they finish, so the texture briefly mixes old and new slices
+    bool building = false;
+    float buildSpin = 0.0f;
+    float requestedSpin = 0.0f;
+    std::vector<float> staging;
+    JobGroup groups[KERR_MAP_SLICES];
+    bool uploaded[KERR_MAP_SLICES] = {};
+};
+
+// Maps the cached map for `spin`, or builds it on the job system and waits (startup)
+void LoadKerrLensMap(KerrLensMap& map, JobSystem& jobs, const AssetCache& cache, float spin, float diskOuter);
+void UnloadKerrLensMap(KerrLensMap& map, JobSystem& jobs);
+
+// Asks for a map at a new spin; the rebuild (or cache load) starts on the next
+// update and requests made while one is running are coalesced into the next
+void RequestKerrLensMap(KerrLensMap& map, float spin);
+
+// Once per frame: starts a pending rebuild and uploads finished slices.
+// Returns true on the frame a rebuild completes.
+bool UpdateKerrLensMap(KerrLensMap& map, JobSystem& jobs);
+
+// Inclination of the slice `index`, and the fractional slice for an inclination
+float GetKerrSliceInclination(int index);
+float GetKerrSliceCoord(float inclination);
@@ -0,0 +1,141 @@
+#include "lens_shader.h"
+
+#include <cstring>
+
+#include "gl_ext.h"
+
+namespace {
+
+// Stage names for the command line and report, and the macros lensing.fs tests
+const char* const STAGE_NAMES[LENS_STAGE_COUNT] = {"fxaa", "bloom", "chromatic", "contrast"};
+const char* const STAGE_DEFINES[LENS_STAGE_COUNT] = {"FXAA", "BLOOM", "CHROMATIC_ABERRATION", "CONTRAST_BOOST"};
+
+// `source` with a #define per stage in `stages` after its #version line
+std::string WithStageDefines(const char* source, unsigned stages) {
+    std::string code = source;
+    size_t line = code.find("#version");
+    size_t at = line == std::string::npos ? 0 : code.find('\n', line);
+    at = at == std::string::npos ? code.size() : at + 1;
+    std::string defines;
+    for (int i = 0; i < LENS_STAGE_COUNT; i++) {
+        if (stages & (1u << i)) defines += std::string("#define ") + STAGE_DEFINES[i] + "\n";
+    }
+    return code.insert(at, defines);
+}
+
+// raylib logs compile errors itself and falls back to its default shader
+Shader LoadPermutation(const char* source, unsigned stages) {
+    return LoadShaderFromMemory(nullptr, WithStageDefines(source, stages).c_str());
+}
+
+const gl::GLuint HOLE_BLOCK_BINDING = 0;
+
+// Points the program's Holes block at the shared buffer; the default shader
+// raylib falls back to has no such block
+void BindHoleBlock(const Shader& shader) {
+    gl::GLuint index = gl::GetUniformBlockIndex(shader.id, "Holes");
+    if (index != gl::INVALID_INDEX) gl::UniformBlockBinding(shader.id, index, HOLE_BLOCK_BINDING);
+}
+
+} // namespace
+
+LensShaders LoadLensShaders() {
+    LensShaders s;
+    int liteCount = 0;
+    char* lensSource = LoadFileText("lensing.fs");
+    char* liteSource = LoadFileText("lensing_lite.fs");
+    if (!lensSource || !liteSource) TraceLog(LOG_ERROR, "LENS: Failed to read lensing.fs / lensing_lite.fs");
+
+    for (unsigned stages = 0; stages < (unsigned)LENS_PERMUTATIONS; stages++) {
+        LensProgram& p = s.lens[stages];
+        p.shader = LoadPermutation(lensSource ? lensSource : "", stages);
+        p.resLoc = GetShaderLocation(p.shader, "resolution");
+        p.timeLoc = GetShaderLocation(p.shader, "time");
+        p.lensModelLoc = GetShaderLocation(p.shader, "lensModel");
+        p.deflectionLoc = GetShaderLocation(p.shader, "deflectionLUT");
+        p.deflectionRangeLoc = GetShaderLocation(p.shader, "deflectionRange");
+        p.lensScaleLoc = GetShaderLocation(p.shader, "lensScale");
+        p.kerrMapLoc = GetShaderLocation(p.shader, "kerrMap");
+        p.kerrExtentLoc = GetShaderLocation(p.shader, "kerrExtent");
+        p.volumeModeLoc = GetShaderLocation(p.shader, "diskVolumeMode");
+        p.volumeLoc = GetShaderLocation(p.shader, "diskVolume");
+        p.bloomLoc = GetShaderLocation(p.shader, "bloomTexture");
+        p.bloomIntensityLoc = GetShaderLocation(p.shader, "bloomIntensity");
+        BindHoleBlock(p.shader);
+
+        if ((stages & ~LITE_STAGES) != 0) continue;
+        LiteProgram& l = s.lite[stages];
+        liteCount++;
+        l.shader = LoadPermutation(liteSource ? liteSource : "", stages);
+        l.resLoc = GetShaderLocation(l.shader, "resolution");
+        l.volumeModeLoc = GetShaderLocation(l.shader, "diskVolumeMode");
+        l.volumeLoc = GetShaderLocation(l.shader, "diskVolume");
+        l.bloomLoc = GetShaderLocation(l.shader, "bloomTexture");
+        l.bloomIntensityLoc = GetShaderLocation(l.shader, "bloomIntensity");
+        BindHoleBlock(l.shader);
+    }
+    UnloadFileText(lensSource);
+    UnloadFileText(liteSource);
+
+    gl::GenBuffers(1, &s.holeBuffer);
+    gl::BindBuffer(gl::UNIFORM_BUFFER, s.holeBuffer);
+    gl::BufferData(gl::UNIFORM_BUFFER, sizeof(LensHoleBlock), nullptr, gl::DYNAMIC_DRAW);
+    gl::BindBuffer(gl::UNIFORM_BUFFER, 0);
+    gl::BindBufferBase(gl::UNIFORM_BUFFER, HOLE_BLOCK_BINDING, s.holeBuffer);
+    TraceLog(LOG_INFO, "LENS: Compiled %d lensing.fs and %d lensing_lite.fs permutations", LENS_PERMUTATIONS, liteCount);
+    return s;
+}
+
+void UnloadLensShaders(LensShaders& s) {
+    for (unsigned stages = 0; stages < (unsigned)LENS_PERMUTATIONS; stages++) {
+        UnloadShader(s.lens[stages].shader);
+        if ((stages & ~LITE_STAGES) == 0) UnloadShader(s.lite[stages].shader);
+    }
+    gl::DeleteBuffers(1, &s.holeBuffer);
+    s = {};
+}
+
+void UploadLensHoles(const LensShaders& s, const LensHoleBlock& block) {
+    gl::BindBuffer(gl::UNIFORM_BUFFER, s.holeBuffer);
+    gl::BufferSubData(gl::UNIFORM_BUFFER, 0, sizeof(LensHoleBlock), &block);
+    gl::BindBuffer(gl::UNIFORM_BUFFER, 0);
+}
+
+const LensProgram& GetLensProgram(const LensShaders& s, unsigned stages) {
+    return s.lens[stages & LENS_STAGES_ALL];
+}
+
+const LiteProgram& GetLiteProgram(const LensShaders& s, unsigned stages) {
+    return s.lite[stages & LITE_STAGES];
+}
+
+std::string FormatLensStages(unsigned stages) {
+    std::string out;
+    for (int i = 0; i < LENS_STAGE_COUNT; i++) {
+        if (!(stages & (1u << i))) continue;
+        if (!out.empty()) out += "+";
+        out += STAGE_NAMES[i];
+    }
+    return out.empty() ? "none" : out;
+}
+
+bool ParseLensStages(const char* list, unsigned& stages) {
+    if (strcmp(list, "all") == 0) {
+        stages = LENS_STAGES_ALL;
+        return true;
+    }
+    stages = 0;
+    if (strcmp(list, "none") == 0) return true;
+    for (const char* p = list; *p;) {
+        size_t len = strcspn(p, ",");
+        int found = -1;
+        for (int i = 0; i < LENS_STAGE_COUNT; i++) {
+            if (strlen(STAGE_NAMES[i]) == len && strncmp(p, STAGE_NAMES[i], len) == 0) found = i;
+        }
+        if (found < 0) return false;
+        stages |= 1u << found;
+        p += len;
+        if (*p == ',') p++;
+    }
+    return true;
+}
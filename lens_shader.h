@@ -0,0 +1,88 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <string>
+
+// Lensing pass programs. lensing.fs and lensing_lite.fs are compiled once per
+// combination of their optional stages, with a #define per enabled stage, and
+// every permutation is built at startup so switching costs nothing mid-run.
+// A stage that is switched off is absent from the program rather than skipped
+// by a uniform; the quality governor and --lens-stages pick the set.
+//
+// The black holes themselves are not uniforms of any one program: their screen
+// data lives in a single uniform buffer (the Holes block, std140) bound to
+// every permutation, filled once per frame with UploadLensHoles().
+
+enum LensStage : unsigned {
+    LENS_FXAA = 1 << 0,              // FXAA on the lensed fetch (never under TAA)
+    LENS_BLOOM = 1 << 1,             // Bloom composite; main.cpp skips the chain too
+    LENS_CHROMATIC = 1 << 2,         // Chromatic aberration at the shadow edge
+    LENS_CONTRAST = 1 << 3,          // Local contrast boost around the hole
+};
+
+const int LENS_STAGE_COUNT = 4;
+const unsigned LENS_STAGES_ALL = (1u << LENS_STAGE_COUNT) - 1;
+const int LENS_PERMUTATIONS = 1 << LENS_STAGE_COUNT;
+// lensing_lite.fs only has the stages that still apply outside the lens
+const unsigned LITE_STAGES = LENS_BLOOM | LENS_CONTRAST;
+
+// Must match lensing.fs and lensing_lite.fs; MAX_VIEWS also the scene vertex shaders
+const int MAX_HOLES = 8;
+const int MAX_VIEWS = 4;
+
+// std140 mirror of lensing.fs's Hole struct
+struct LensHole {
+    float x, y;           // Centre in uv
+    float rsScreen;       // Rs in screen-height units
+    float radius;         // Artistic model's horizon, in screen-width units
+    float reach;          // Distance at which the lens has faded out; 0: unbounded
+    float kerrSlice;      // Fractional Kerr map slice for the camera's inclination
+    float kerrFlip;       // -1 below the disk plane
+    float pad;
+};
+
+// View v's holes are holes[v * holeCount + i] (multi-view atlas)
+struct LensHoleBlock {
+    LensHole holes[MAX_HOLES * MAX_VIEWS];
+    int holeCount;
+    int viewCount;
+    int pad[2];
+};
+static_assert(sizeof(LensHoleBlock) == 1040, "LensHoleBlock must match the std140 Holes block");
+
+// One lensing.fs permutation and its uniform locations; locations differ per
+// program, so each permutation keeps its own
+struct LensProgram {
+    Shader shader = {0};
+    int resLoc, timeLoc;
+    int lensModelLoc, deflectionLoc, deflectionRangeLoc, lensScaleLoc;
+    int kerrMapLoc, kerrExtentLoc;
+    int volumeModeLoc, volumeLoc, bloomLoc, bloomIntensityLoc;
+};
+
+// A lensing_lite.fs permutation (bounded mode [G])
+struct LiteProgram {
+    Shader shader = {0};
+    int resLoc, volumeModeLoc, volumeLoc, bloomLoc, bloomIntensityLoc;
+};
+
+struct LensShaders {
+    LensProgram lens[LENS_PERMUTATIONS];
+    LiteProgram lite[LENS_PERMUTATIONS];  // Only LITE_STAGES combinations are compiled
+    unsigned holeBuffer = 0;              // Uniform buffer behind the Holes block
+};
+
+LensShaders LoadLensShaders();
+void UnloadLensShaders(LensShaders& s);
+
+// Fills the Holes block every lensing pass reads this frame
+void UploadLensHoles(const LensShaders& s, const LensHoleBlock& block);
+
+const LensProgram& GetLensProgram(const LensShaders& s, unsigned stages);
+const LiteProgram& GetLiteProgram(const LensShaders& s, unsigned stages);
+
+// "fxaa+bloom+chromatic+contrast", or "none"
+std::string FormatLensStages(unsigned stages);
+// Comma-separated stage names, "all" or "none"; false on an unknown name
+bool ParseLensStages(const char* list, unsigned& stages);
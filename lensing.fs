@@ -1,20 +1,68 @@
 #version 330
 
+// Optional stages, compiled in by lens_shader.cpp's #define lines after the
+// version (one program per combination, so a disabled stage costs nothing):
+//   FXAA                  anti-aliasing of the lensed fetch (off under TAA)
+//   BLOOM                 composite of the bloom chain
+//   CHROMATIC_ABERRATION  colour fringe at the shadow edge
+//   CONTRAST_BOOST        local contrast lift around the hole
 in vec2 fragTexCoord;
 out vec4 finalColor;
 
 uniform sampler2D texture0;
+#ifdef BLOOM
+uniform sampler2D bloomTexture;  // Result of the downsample/blur/upsample chain (half res)
+uniform float bloomIntensity;
+#endif
 uniform vec2 resolution;
-uniform vec2 blackHolePos;
-uniform float blackHoleRadius;
 uniform float time;
 
+// Every black hole in the scene (main.cpp's HoleBlock, std140). Each pixel sums
+// the deflection of the holes that reach it, in one pass; the others are culled
+// by distance before any texture is read. In multi-view the frame is an atlas
+// of viewCount columns, and view v's holes are holes[v * holeCount + i].
+const int MAX_HOLES = 8;
+const int MAX_VIEWS = 4;
+struct Hole {
+    vec4 screen;  // xy: centre (uv), z: Rs in screen-height units, w: artistic radius
+    vec4 lens;    // x: reach (same units as dist, 0: unbounded), y: Kerr slice, z: Kerr flip
+};
+layout(std140) uniform Holes {
+    Hole holes[MAX_HOLES * MAX_VIEWS];
+    int holeCount;
+    int viewCount;
+};
+
+// Schwarzschild deflection table (lensModel 1), built by integrating null
+// geodesics at startup: α(b) in radians, addressed by x = √((b - bCrit) / (bMax - bCrit))
+uniform int lensModel;            // 0: artistic falloff, 1: geodesic deflection table, 2: Kerr map
+uniform sampler2D deflectionLUT;
+uniform vec2 deflectionRange;     // (bCrit, bMax) in units of Rs
+uniform float lensScale;          // uv offset per radian of deflection (source distance / fov)
+
+// Kerr map (lensModel 2, kerr_lens.h): KERR_MAP_SLICES square slices stacked
+// bottom to top, one per inclination, each covering ±kerrExtent Rs of image
+// plane. rg: screen bend (radians), b: escaped, a: disk redshift g. Each hole
+// has its own fractional slice for the camera's inclination, and a flip of -1
+// below the disk plane, where the map mirrors in y
+uniform sampler2D kerrMap;
+uniform float kerrExtent;
+
+// Volumetric disk [V]: premultiplied radiance and opacity at this pixel. Its
+// rays were already bent while marching, so it is sampled undistorted and
+// composited over the lensed scene
+uniform int diskVolumeMode;
+uniform sampler2D diskVolume;
+
 // Schwarzschild metric parameters (normalized units where Rs = 1)
 const float RS_SCALE = 1.0;
 const float PHOTON_SPHERE = 1.5;  // Unstable photon orbit at r = 1.5 Rs
 const float EINSTEIN_RING = 2.6;  // Critical impact parameter for lensing
+const float PI = 3.14159265;
 
+#ifdef FXAA
 // ===== FXAA (Fast Approximate Anti-Aliasing) =====
+// Left out under TAA [T], which resolves the jittered frames in taa.fs instead
 // Nvidia's FXAA 3.11 algorithm - edge detection based on luminance gradient
 // Reduces aliasing without geometry information, ideal for post-process pipeline
 const float FXAA_SPAN_MAX = 8.0;
@@ -68,134 +116,201 @@ vec3 applyFXAA(sampler2D tex, vec2 uv, vec2 texelSize) {
     }
     return rgbB;
 }
-
-// Legacy function for reference - not currently used
-vec4 getDistortedColor(vec2 uv, vec2 center, float aspect, float rs) {
-    vec2 delta = uv - center;
-    delta.x *= aspect;
-    float dist = length(delta);
-
-    vec2 distortedUV = uv;
-
-    if (dist > rs * 0.1) {
-        float deflection = rs * rs / (dist * dist + rs * 0.1);
-        vec2 dir = normalize(delta);
-        dir.x /= aspect;
-
-        float wrapFactor = 1.0;
-        if (dist < rs * 3.0 && dist > rs) {
-            wrapFactor = 1.0 + 0.5 * exp(-(dist - rs * 1.5) * 5.0);
-        }
-
-        distortedUV = uv - dir * deflection * wrapFactor * 1.5;
-    }
-
-    return texture(texture0, distortedUV);
+#endif
+
+// Kerr map texel for image-plane offset b (Rs), blended between the two
+// slices around kerrSlice; uv stays half a texel inside each slice
+vec4 sampleKerrMap(vec2 b, float kerrSlice) {
+    float slices = float(textureSize(kerrMap, 0).y) / float(textureSize(kerrMap, 0).x);
+    float size = float(textureSize(kerrMap, 0).x);
+    vec2 st = clamp(b / kerrExtent * 0.5 + 0.5, 0.5 / size, 1.0 - 0.5 / size);
+    float s0 = floor(kerrSlice);
+    float s1 = min(s0 + 1.0, slices - 1.0);
+    vec4 a = textureLod(kerrMap, vec2(st.x, (s0 + st.y) / slices), 0.0);
+    vec4 c = textureLod(kerrMap, vec2(st.x, (s1 + st.y) / slices), 0.0);
+    return mix(a, c, kerrSlice - s0);
 }
 
 void main() {
     vec2 uv = fragTexCoord;
-    vec2 center = blackHolePos;
-    vec2 texelSize = 1.0 / resolution;
-
     float aspect = resolution.x / resolution.y;
-    vec2 delta = uv - center;
-    delta.x *= aspect;
-    float dist = length(delta);  // Impact parameter b (distance from optical axis)
-    float rs = blackHoleRadius * RS_SCALE;
+    vec4 volume = diskVolumeMode == 1 ? texture(diskVolume, uv) : vec4(0.0);
+    int view = min(int(uv.x * float(viewCount)), viewCount - 1);
 
     // ===== GRAVITATIONAL LENSING =====
     // Approximates light deflection using weak-field Schwarzschild metric
     // True deflection angle: θ = 4GM/(c²b) = 2Rs/b
-    vec2 distortedUV = uv;
-
-    if (dist > rs * 0.1) {
-        // Deflection magnitude falls off as 1/b² (simplified from exact solution)
-        // Added softening term (rs * 0.1) prevents singularity at center
-        float deflection = rs * rs / (dist * dist + rs * 0.1);
+    // With several holes each bends the ray independently and the uv offsets
+    // add, as thin lenses do in the weak field; shadows and Kerr redshifts
+    // multiply and the glows add.
+    vec2 offset = vec2(0.0);
+    float shadow = 1.0;
+    float redshift = 1.0;
+    float innerGlow = 0.0;
+    vec2 fringe = vec2(1.0);  // Chromatic aberration: red and blue gains
+    float window = 0.0;       // Strongest lens fade at this pixel (FXAA follows it)
+    float nearest = 1e9;      // Distance to the closest hole, for the contrast boost
+    bool captured = false;
+
+    for (int i = 0; i < holeCount; i++) {
+        Hole hole = holes[view * holeCount + i];
+        vec2 delta = uv - hole.screen.xy;
+        delta.x *= aspect;
+        float dist = length(delta);  // Impact parameter b (distance from optical axis)
+        nearest = min(nearest, dist);
+
+        // Out of reach: the lens would move this pixel by less than LENS_BOUND_SHIFT_PX
+        float reach = hole.lens.x;
+        if (reach > 0.0 && dist >= reach) continue;
+
+        float rsScreen = hole.screen.z;
+        float rs = hole.screen.w * RS_SCALE;
         vec2 dir = normalize(delta);
         dir.x /= aspect;
+        vec2 bend = vec2(0.0);
+
+        // Radius of the captured region and width of its soft edge; the artistic
+        // model uses the inflated horizon, the geodesic table the true 2.6 Rs shadow
+        float edge = rs;
+        float edgeSoftness = 1.3;
+        // Kerr map: share of the pixel's rays that escape (the shadow is off-centre
+        // and flattened on the approaching side), and the disk's g³ intensity shift
+        float escape = 1.0;
+
+        if (lensModel == 2) {
+            vec2 b = delta / rsScreen;  // Image-plane offset in Rs, x right, y up
+            float kerrFlip = hole.lens.z;
+            edge = deflectionRange.x * rsScreen;
+            if (max(abs(b.x), abs(b.y)) < kerrExtent) {
+                vec4 kerr = sampleKerrMap(vec2(b.x, b.y * kerrFlip), hole.lens.y);
+                escape = kerr.b;
+                redshift *= clamp(kerr.a * kerr.a * kerr.a, 0.3, 2.5);
+                bend = vec2(kerr.r / aspect, kerr.g * kerrFlip) * lensScale;
+            } else {
+                // Outside the map spin only matters at second order: weak field as in model 1
+                float bl = length(b);
+                float alpha = 2.0 / bl + (15.0 * PI / 16.0) / (bl * bl);
+                bend = -dir * alpha * lensScale;
+            }
+        } else if (lensModel == 1) {
+            float b = dist / rsScreen;  // Impact parameter in units of Rs
+            edge = deflectionRange.x * rsScreen;
+            edgeSoftness = 1.05;
+
+            if (b > deflectionRange.x) {
+                // Exact strong-field deflection; beyond the table the weak-field
+                // expansion 2Rs/b + (15π/16)(Rs/b)² takes over
+                float alpha = 2.0 / b + (15.0 * PI / 16.0) / (b * b);
+                if (b < deflectionRange.y) {
+                    float x = sqrt((b - deflectionRange.x) / (deflectionRange.y - deflectionRange.x));
+                    alpha = texture(deflectionLUT, vec2(x, 0.5)).r;
+                }
+                // Rays bent past π come back toward the observer; screen space can't show that
+                bend = -dir * min(alpha, PI) * lensScale;
+            }
+        } else if (dist > rs * 0.1) {
+            // Deflection magnitude falls off as 1/b² (simplified from exact solution)
+            // Added softening term (rs * 0.1) prevents singularity at center
+            float deflection = rs * rs / (dist * dist + rs * 0.1);
+
+            // Strong-field correction near photon sphere
+            // Light paths here can wrap partially around the black hole
+            float wrapFactor = 1.0;
+            if (dist < rs * 3.0 && dist > rs) {
+                wrapFactor = 1.0 + 0.5 * exp(-(dist - rs * 1.5) * 5.0);
+            }
+
+            // Negative direction: light bends toward mass, so we sample "outward"
+            bend = -dir * deflection * wrapFactor * 1.5;
+        }
 
-        // Strong-field correction near photon sphere
-        // Light paths here can wrap partially around the black hole
-        float wrapFactor = 1.0;
-        if (dist < rs * 3.0 && dist > rs) {
-            wrapFactor = 1.0 + 0.5 * exp(-(dist - rs * 1.5) * 5.0);
+        // Fade the deflection out towards the reach, so pixels beyond it match
+        // lensing_lite.fs in bounded mode and culling leaves no seam
+        float fade = reach > 0.0 ? 1.0 - smoothstep(reach * 0.5, reach, dist) : 1.0;
+        offset += bend * fade;
+        window = max(window, fade);
+        captured = captured || (lensModel == 2 ? escape <= 0.0 : dist < edge * 0.9);
+
+        // ===== EVENT HORIZON SHADOW =====
+        // Region where all light paths terminate at singularity
+        // Shadow edge is actually at ~2.6 Rs (photon capture radius) not Rs
+        // ===== INNER ACCRETION GLOW =====
+        // Represents emission from innermost stable orbit region
+        // Color temperature ~10^7 K would be X-ray, shifted to visible for effect
+        if (lensModel == 2) {
+            // Bilinear escape flag already gives a one-texel soft edge, and a
+            // thin rim follows the true (asymmetric) shadow edge
+            shadow *= escape * escape;
+            innerGlow += 4.0 * escape * (1.0 - escape) * 0.2;
+        } else {
+            if (dist < edge) {
+                shadow = 0.0;
+            } else if (dist < edge * edgeSoftness) {
+                // Smooth falloff prevents hard edge artifacts
+                float s = smoothstep(edge, edge * edgeSoftness, dist);
+                shadow *= s * s;  // Quadratic falloff for softer transition
+            }
+            // Exponential falloff models optically thin emission
+            if (dist > edge && dist < edge * 2.5) innerGlow += exp(-(dist - edge) * 4.0) * 0.2;
         }
 
-        // Negative direction: light bends toward mass, so we sample "outward"
-        distortedUV = uv - dir * deflection * wrapFactor * 1.5;
+#ifdef CHROMATIC_ABERRATION
+        // ===== CHROMATIC ABERRATION =====
+        // Simulates wavelength-dependent refraction near horizon
+        // Red light deflects slightly less than blue in strong gravity
+        if (dist > edge * 0.9 && dist < edge * 1.5) {
+            float chromatic = smoothstep(edge * 0.9, edge * 1.2, dist);
+            fringe *= vec2(1.0 + (1.0 - chromatic) * 0.1, 1.0 - (1.0 - chromatic) * 0.05);
+        }
+#endif
     }
 
+    // Pure black inside the shadow core (no light escapes), so skip the
+    // FXAA and bloom fetches. Scene geometry behind the hole can't be culled the
+    // same way: the deflection above pulls samples inwards, and every point of
+    // the shadow disc is read by some visible pixel outside it (the lensed arcs).
+    // Gas in front of the hole still has to be composited
+    if (captured && volume.a <= 0.0) {
+        finalColor = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    vec2 distortedUV = uv + offset;
+    if (viewCount > 1) {
+        // Keep the lensed fetch inside this view's column of the atlas
+        float texel = 0.5 / resolution.x;
+        distortedUV.x = clamp(distortedUV.x, float(view) / float(viewCount) + texel,
+                              float(view + 1) / float(viewCount) - texel);
+    }
+    vec3 aaColor = texture(texture0, distortedUV).rgb;
+#ifdef FXAA
     // Apply FXAA to reduce aliasing artifacts from distortion sampling
-    vec3 aaColor = applyFXAA(texture0, distortedUV, texelSize);
+    aaColor = mix(aaColor, applyFXAA(texture0, distortedUV, 1.0 / resolution), window);
+#endif
     vec4 texColor = vec4(aaColor, 1.0);
 
+#ifdef BLOOM
     // ===== BLOOM (HDR Glow Simulation) =====
     // Approximates light scattering in camera lens/eye for bright sources
-    // Real bloom would use separable Gaussian blur for efficiency
-    vec3 bloom = vec3(0.0);
-    float bloomSamples = 12.0;
-    float bloomRadius = 0.025;
-    for (float i = 0.0; i < bloomSamples; i++) {
-        float angle = i / bloomSamples * 6.28318;
-        vec2 offset = vec2(cos(angle), sin(angle)) * bloomRadius;
-        vec3 sampleColor = texture(texture0, distortedUV + offset).rgb;
-        // Threshold filter: only bright pixels contribute to bloom
-        float brightness = dot(sampleColor, vec3(0.299, 0.587, 0.114));
-        if (brightness > 0.4) {
-            bloom += sampleColor * (brightness - 0.4) * 0.5;
-        }
-    }
-    texColor.rgb += bloom / bloomSamples;
-
-    // ===== EVENT HORIZON SHADOW =====
-    // Region where all light paths terminate at singularity
-    // Shadow edge is actually at ~2.6 Rs (photon capture radius) not Rs
-    float shadow = 1.0;
-    float eventHorizon = rs * 1.0;
-
-    if (dist < eventHorizon) {
-        shadow = 0.0;
-    } else if (dist < eventHorizon * 1.3) {
-        // Smooth falloff prevents hard edge artifacts
-        shadow = smoothstep(eventHorizon, eventHorizon * 1.3, dist);
-        shadow *= shadow;  // Quadratic falloff for softer transition
-    }
-
-    // ===== INNER ACCRETION GLOW =====
-    // Represents emission from innermost stable orbit region
-    // Color temperature ~10^7 K would be X-ray, shifted to visible for effect
-    vec3 warmGlow = vec3(1.0, 0.6, 0.3);
-
-    float innerGlow = 0.0;
-    if (dist > rs && dist < rs * 2.5) {
-        // Exponential falloff models optically thin emission
-        innerGlow = exp(-(dist - rs) * 4.0) * 0.2;
-    }
+    // Thresholded, downsampled and separably blurred in main.cpp (bloom_*.fs);
+    // sampled at the lensed position so the glow follows the distortion
+    texColor.rgb += texture(bloomTexture, distortedUV).rgb * bloomIntensity;
+#endif
 
     // ===== COMPOSITING =====
-    texColor.rgb *= shadow;
+    vec3 warmGlow = vec3(1.0, 0.6, 0.3);
+    texColor.rgb *= shadow * redshift;
     texColor.rgb += warmGlow * innerGlow * shadow;
-
-    // Enforce pure black inside event horizon (no light escape)
-    if (dist < rs * 0.9) {
-        texColor.rgb = vec3(0.0);
-    }
-
-    // ===== CHROMATIC ABERRATION =====
-    // Simulates wavelength-dependent refraction near horizon
-    // Red light deflects slightly less than blue in strong gravity
-    if (dist > rs * 0.9 && dist < rs * 1.5) {
-        float chromatic = smoothstep(rs * 0.9, rs * 1.2, dist);
-        texColor.r *= 1.0 + (1.0 - chromatic) * 0.1;
-        texColor.b *= 1.0 - (1.0 - chromatic) * 0.05;
-    }
+    texColor.rgb = texColor.rgb * (1.0 - volume.a) + volume.rgb;
+    texColor.r *= fringe.x;
+    texColor.b *= fringe.y;
 
     // ===== TONE MAPPING & COLOR GRADING =====
+#ifdef CONTRAST_BOOST
     // Local contrast enhancement near black hole
-    float contrastBoost = 1.0 + 0.3 * exp(-dist * 5.0);
+    float contrastBoost = 1.0 + 0.3 * exp(-nearest * 5.0);
     texColor.rgb = pow(texColor.rgb, vec3(1.0 / contrastBoost));
+#endif
 
     // Reinhard tone mapping: maps HDR to displayable range
     // Preserves highlight detail better than simple clamp
@@ -0,0 +1,61 @@
+#version 330
+
+// Lensing pass outside the black holes' regions of influence (bounded mode)
+// Where lensing.fs's deflection, shadow, glow and chromatic terms have all
+// reached zero only the bloom composite and the tone curve remain; FXAA is
+// skipped since there is no distortion sampling here to alias. Compiled with
+// the same BLOOM and CONTRAST_BOOST defines as lensing.fs, so the seam matches
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+#ifdef BLOOM
+uniform sampler2D bloomTexture;
+uniform float bloomIntensity;
+#endif
+uniform vec2 resolution;
+uniform int diskVolumeMode;     // Volumetric disk, composited as in lensing.fs
+uniform sampler2D diskVolume;
+
+// Same block as lensing.fs; only the centres are read here
+const int MAX_HOLES = 8;
+const int MAX_VIEWS = 4;
+struct Hole {
+    vec4 screen;
+    vec4 lens;
+};
+layout(std140) uniform Holes {
+    Hole holes[MAX_HOLES * MAX_VIEWS];
+    int holeCount;
+    int viewCount;
+};
+
+void main() {
+    vec2 uv = fragTexCoord;
+
+    vec4 texColor = vec4(texture(texture0, uv).rgb, 1.0);
+#ifdef BLOOM
+    texColor.rgb += texture(bloomTexture, uv).rgb * bloomIntensity;
+#endif
+    if (diskVolumeMode == 1) {
+        vec4 volume = texture(diskVolume, uv);
+        texColor.rgb = texColor.rgb * (1.0 - volume.a) + volume.rgb;
+    }
+
+    // Same tone mapping and grading as the end of lensing.fs
+#ifdef CONTRAST_BOOST
+    float nearest = 1e9;
+    int view = min(int(uv.x * float(viewCount)), viewCount - 1);
+    for (int i = 0; i < holeCount; i++) {
+        vec2 delta = uv - holes[view * holeCount + i].screen.xy;
+        delta.x *= resolution.x / resolution.y;
+        nearest = min(nearest, length(delta));
+    }
+    float contrastBoost = 1.0 + 0.3 * exp(-nearest * 5.0);
+    texColor.rgb = pow(texColor.rgb, vec3(1.0 / contrastBoost));
+#endif
+    texColor.rgb = texColor.rgb / (texColor.rgb + vec3(1.0));
+    texColor.rgb = pow(texColor.rgb, vec3(1.0 / 2.2)) * 1.2;
+
+    finalColor = texColor;
+}
@@ -0,0 +1,50 @@
+#version 330
+
+// Static ring geometry (disk, Einstein ring, photon sphere, inner glow)
+// Built once on the CPU; only the photon sphere shimmer depends on time
+// Disk-colored vertices carry (t, D) and fetch their color from the disk LUT
+layout(location = 0) in vec3 vertexPosition;
+layout(location = 1) in vec2 vertexTexCoord;  // x: flicker phase, y: flicker amplitude
+layout(location = 3) in vec4 vertexColor;
+layout(location = 5) in vec2 vertexTexCoord2; // x: disk temperature t (< 0: no LUT), y: Doppler D
+
+// Multi-view atlas (main.cpp's ViewSet): instance i draws view i with mvp[i]
+// into column i of viewCount; one view is an ordinary draw
+const int MAX_VIEWS = 4;
+uniform mat4 mvp[MAX_VIEWS];
+uniform int viewCount;
+uniform float time;            // Seconds since the epoch, see GPU_TIME_EPOCH in main.cpp
+uniform sampler2D diskLUT;
+uniform vec2 lutDopplerRange;  // D at the first / last LUT row
+
+out vec4 fragColor;
+
+// Texel-center addressing so t = 0..1 and D = min..max hit the first/last texels
+vec3 sampleDiskLUT(float t, float doppler) {
+    vec2 size = vec2(textureSize(diskLUT, 0));
+    vec2 uv = vec2(t, (doppler - lutDopplerRange.x) / (lutDopplerRange.y - lutDopplerRange.x));
+    uv = (clamp(uv, 0.0, 1.0) * (size - 1.0) + 0.5) / size;
+    return textureLod(diskLUT, uv, 0.0).rgb;
+}
+
+// Squeezes a view's clip-space position into its atlas column; the clip
+// distances cut it at the column's edges (enabled by main.cpp in multi-view)
+vec4 atlasPosition(vec4 clip) {
+    gl_ClipDistance[0] = clip.w + clip.x;
+    gl_ClipDistance[1] = clip.w - clip.x;
+    float n = float(max(viewCount, 1));
+    clip.x = (clip.x + clip.w * (1.0 + 2.0 * float(gl_InstanceID) - n)) / n;
+    return clip;
+}
+
+void main() {
+    vec3 color = vertexColor.rgb;
+    if (vertexTexCoord2.x >= 0.0) color = sampleDiskLUT(vertexTexCoord2.x, vertexTexCoord2.y);
+
+    // Amplitude 0 leaves the color untouched, 0.1 gives 0.9 + 0.1·sin(3θ + 2t)
+    float amp = vertexTexCoord.y;
+    float flicker = 1.0 - amp + amp * sin(vertexTexCoord.x + time * 2.0);
+
+    fragColor = vec4(color * flicker, vertexColor.a);
+    gl_Position = atlasPosition(mvp[gl_InstanceID] * vec4(vertexPosition, 1.0));
+}
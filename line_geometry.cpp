@@ -0,0 +1,154 @@
+#include "line_geometry.h"
+
+#include <cmath>
+
+#include <raylib.h>
+
+#include "disk_color.h"
+
+namespace {
+
+void AppendSegment(std::vector<LineVertex>& v, Vector3 p1, Vector3 p2, Color c,
+                   float phase = 0.0f, float flicker = 0.0f) {
+    v.push_back({p1.x, p1.y, p1.z, c.r, c.g, c.b, c.a, phase, flicker, -1.0f, 0.0f});
+    v.push_back({p2.x, p2.y, p2.z, c.r, c.g, c.b, c.a, phase, flicker, -1.0f, 0.0f});
+}
+
+// Segment colored by GetDiskColor(t, doppler) through the LUT, with explicit alpha
+void AppendDiskSegment(std::vector<LineVertex>& v, Vector3 p1, Vector3 p2,
+                       float t, float doppler, unsigned char alpha) {
+    v.push_back({p1.x, p1.y, p1.z, 255, 255, 255, alpha, 0.0f, 0.0f, t, doppler});
+    v.push_back({p2.x, p2.y, p2.z, 255, 255, 255, alpha, 0.0f, 0.0f, t, doppler});
+}
+
+// Accretion disk - thin disk approximation in equatorial plane
+void AppendDiskRings(std::vector<LineVertex>& v, float rIn, float rOut, int segments) {
+    for (int ring = 0; ring < DISK_RINGS; ring++) {
+        float r = rIn + (float)ring / DISK_RINGS * (rOut - rIn);
+        float temp = (float)ring / DISK_RINGS;
+        float beta = 0.4f / sqrtf(r / rIn);
+        for (int i = 0; i < segments; i++) {
+            float a1 = (float)i / segments * PI * 2.0f;
+            float a2 = (float)(i + 1) / segments * PI * 2.0f;
+
+            AppendDiskSegment(v, {cosf(a1) * r, 0, sinf(a1) * r}, {cosf(a2) * r, 0, sinf(a2) * r},
+                              temp, DopplerFactor(beta, cosf(a1), 0.4f, 1.8f),
+                              (unsigned char)(220 - temp * 100));
+        }
+    }
+}
+
+// Einstein ring - gravitationally lensed image of the back side of the disk
+// Light from behind the BH bends over/under, creating bright arcs
+void AppendEinsteinRing(std::vector<LineVertex>& v, float bhRadius, int segments) {
+    for (int side = 0; side < 2; side++) {
+        float yDir = (side == 0) ? 1.0f : -1.0f;
+
+        for (int layer = 0; layer < EINSTEIN_LAYERS; layer++) {
+            float layerT = (float)layer / EINSTEIN_LAYERS;
+            float ringR = bhRadius * (2.2f + layerT * 1.8f);
+            float brightness = 1.0f - layerT * 0.6f;
+
+            // Vertical displacement peaks at sides (θ = π/2, 3π/2)
+            // where light path grazes closest to photon sphere
+            float curveHeight = 1.5f - layerT * 0.3f;
+            // Z compression simulates viewing angle of lensed disk
+            float zComp = 0.15f + layerT * 0.05f;
+
+            for (int i = 0; i < segments; i++) {
+                float a1 = (float)i / segments * PI * 2.0f;
+                float a2 = (float)(i + 1) / segments * PI * 2.0f;
+                float bend1 = fabsf(sinf(a1)) * curveHeight * yDir;
+                float bend2 = fabsf(sinf(a2)) * curveHeight * yDir;
+
+                AppendDiskSegment(v, {cosf(a1) * ringR, bend1, sinf(a1) * ringR * zComp},
+                                  {cosf(a2) * ringR, bend2, sinf(a2) * ringR * zComp},
+                                  layerT * 0.4f, DopplerFactor(0.25f, cosf(a1), 0.6f, 1.5f),
+                                  (unsigned char)(brightness * 255));
+            }
+        }
+    }
+}
+
+// Photon sphere at r = 1.5 Rs - unstable circular photon orbits
+// Any photon here will either fall in or escape to infinity
+void AppendPhotonSphere(std::vector<LineVertex>& v, float bhRadius, int segments) {
+    for (int layer = 0; layer < PHOTON_LAYERS; layer++) {
+        float r = bhRadius * 1.5f + layer * 0.03f;
+        float alpha = 1.0f - layer * 0.1f;
+        unsigned char c = (unsigned char)(255 * alpha);
+        for (int i = 0; i < segments; i++) {
+            float a1 = (float)i / segments * PI * 2.0f;
+            float a2 = (float)(i + 1) / segments * PI * 2.0f;
+            // Flicker 0.9 + 0.1·sin(3θ + 2t) is applied in line.vs
+            AppendSegment(v, {cosf(a1) * r, 0, sinf(a1) * r}, {cosf(a2) * r, 0, sinf(a2) * r},
+                          {c, (unsigned char)(c*0.9f), (unsigned char)(c*0.7f), 255}, a1 * 3.0f, 0.1f);
+        }
+    }
+}
+
+// Inner glow - represents extreme gravitational redshift near horizon
+// Light escaping from here loses most of its energy climbing out
+void AppendInnerGlow(std::vector<LineVertex>& v, float bhRadius, int segments) {
+    for (int layer = 0; layer < GLOW_LAYERS; layer++) {
+        float r = bhRadius * (1.1f + layer * 0.08f);
+        float alpha = 0.4f - layer * 0.08f;
+        unsigned char c = (unsigned char)(255 * alpha);
+        for (int i = 0; i < segments; i++) {
+            float a1 = (float)i / segments * PI * 2.0f;
+            float a2 = (float)(i + 1) / segments * PI * 2.0f;
+            AppendSegment(v, {cosf(a1) * r, 0, sinf(a1) * r}, {cosf(a2) * r, 0, sinf(a2) * r},
+                          {c, (unsigned char)(c*0.8f), (unsigned char)(c*0.5f), (unsigned char)(alpha * 255)});
+        }
+    }
+}
+
+} // namespace
+
+int LineLODSegments(int baseSegments, int level) {
+    return (int)(baseSegments * LINE_LOD_SCALE[level] + 0.5f);
+}
+
+LineGeometry BuildLineGeometry(float bhRadius, float diskInner, float diskOuter) {
+    float lodTotal = 0.0f;
+    for (float scale : LINE_LOD_SCALE) lodTotal += scale;
+    LineGeometry geo;
+    std::vector<LineVertex>& v = geo.vertices;
+    v.reserve((size_t)(2 * lodTotal * (DISK_RINGS * DISK_SEGMENTS + 2 * EINSTEIN_LAYERS * EINSTEIN_SEGMENTS +
+                                       PHOTON_LAYERS * PHOTON_SEGMENTS + GLOW_LAYERS * GLOW_SEGMENTS)));
+
+    auto appendGroup = [&](LineGroup& group, int baseSegments, float radius, auto&& append) {
+        group.baseSegments = baseSegments;
+        group.radius = radius;
+        for (int level = 0; level < LINE_LOD_LEVELS; level++) {
+            group.lod[level].first = (int)v.size();
+            append(LineLODSegments(baseSegments, level));
+            group.lod[level].count = (int)v.size() - group.lod[level].first;
+        }
+    };
+    appendGroup(geo.disk, DISK_SEGMENTS, diskOuter,
+                [&](int n) { AppendDiskRings(v, diskInner, diskOuter, n); });
+    appendGroup(geo.einstein, EINSTEIN_SEGMENTS, bhRadius * 4.0f,
+                [&](int n) { AppendEinsteinRing(v, bhRadius, n); });
+    appendGroup(geo.photon, PHOTON_SEGMENTS, bhRadius * 1.5f + PHOTON_LAYERS * 0.03f,
+                [&](int n) { AppendPhotonSphere(v, bhRadius, n); });
+    appendGroup(geo.glow, GLOW_SEGMENTS, bhRadius * (1.1f + GLOW_LAYERS * 0.08f),
+                [&](int n) { AppendInnerGlow(v, bhRadius, n); });
+    return geo;
+}
+
+float GetLineGroupDistance(const LineGroup& group, float rho, float y) {
+    return sqrtf((rho - group.radius) * (rho - group.radius) + y * y);
+}
+
+void UpdateLineLOD(LineGroup& group, float distance, float fovy, int height, float maxErrorPx) {
+    float radiusPx = group.radius / fmaxf(distance, 1e-3f) / tanf(fovy * 0.5f) * height * 0.5f;
+    float needed = PI * sqrtf(radiusPx / (2.0f * maxErrorPx));
+
+    // Finer as soon as the current level is too coarse; coarser once the next level down has headroom
+    while (group.level > 0 && LineLODSegments(group.baseSegments, group.level) < needed) group.level--;
+    while (group.level < LINE_LOD_LEVELS - 1 &&
+           LineLODSegments(group.baseSegments, group.level + 1) * LINE_LOD_HYSTERESIS >= needed) {
+        group.level++;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+// Static line geometry: everything except the particles and stars is fixed in
+// world space, so it is tessellated once at startup and drawn from one VBO.
+// Segment counts are the base level of detail (see LINE_LOD_SCALE); ring and
+// layer counts are fixed since they set the disk's radial density and brightness.
+const int DISK_RINGS = 30, DISK_SEGMENTS = 100;
+const int EINSTEIN_LAYERS = 20, EINSTEIN_SEGMENTS = 120;
+const int PHOTON_LAYERS = 8, PHOTON_SEGMENTS = 120;
+const int GLOW_LAYERS = 4, GLOW_SEGMENTS = 60;
+
+// Every group is prebuilt at LINE_LOD_LEVELS tessellations, LINE_LOD_SCALE times
+// its base segment count, and the level is picked per frame from the ring's
+// projected size: enough segments that the chords stay within
+// LINE_LOD_MAX_ERROR_PX of the true circle.
+const int LINE_LOD_LEVELS = 4;
+const float LINE_LOD_SCALE[LINE_LOD_LEVELS] = {2.0f, 1.0f, 0.5f, 0.25f};
+const float LINE_LOD_MAX_ERROR_PX = 0.5f;
+// A coarser level is only taken once it has this much headroom, so views near a
+// threshold don't flip between levels every frame
+const float LINE_LOD_HYSTERESIS = 0.8f;
+
+// GL_LINES vertex. Each segment keeps a flat color, so both endpoints carry the
+// color of the segment start (matches the old per-segment DrawLine3D).
+// phase/flicker feed the photon sphere shimmer evaluated in line.vs.
+// Disk-colored segments store (t, D) instead and line.vs samples the color
+// LUT; lutT < 0 means "use the vertex color as is".
+struct LineVertex {
+    float x, y, z;
+    unsigned char r, g, b, a;
+    float phase, flicker;
+    float lutT, lutD;
+};
+
+struct LineRange { int first, count; };
+
+// One ring group at every LOD level; radius is its largest ring (world units)
+struct LineGroup {
+    LineRange lod[LINE_LOD_LEVELS];
+    int baseSegments = 0;
+    float radius = 0.0f;
+    int level = 1;               // Index into lod; starts at the base tessellation
+};
+
+// Every group's vertices at every LOD level, ready for one static VBO
+struct LineGeometry {
+    std::vector<LineVertex> vertices;
+    LineGroup disk, einstein, photon, glow;
+};
+
+int LineLODSegments(int baseSegments, int level);
+
+// Tessellates the disk rings, Einstein ring, photon sphere and inner glow
+LineGeometry BuildLineGeometry(float bhRadius, float diskInner, float diskOuter);
+
+// Distance from a camera `rho` from the hole's axis and `y` above the disk
+// plane to the nearest point of the group's largest ring. Inside the disk
+// that ring is far closer than the hole's centre, and its chords show most.
+float GetLineGroupDistance(const LineGroup& group, float rho, float y);
+
+// Picks the group's level for a view `distance` from its ring with vertical
+// field of view `fovy` (radians) on a target `height` pixels tall. A circle
+// spanning R pixels drawn with n chords deviates by R(1 - cos(π/n)) ≈ Rπ²/(2n²),
+// held under `maxErrorPx` (LINE_LOD_MAX_ERROR_PX at full quality).
+void UpdateLineLOD(LineGroup& group, float distance, float fovy, int height, float maxErrorPx);
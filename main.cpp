@@ -1,111 +1,1460 @@
 #include <raylib.h>
 #include <raymath.h>
+#include <rlgl.h>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 #include <vector>
 
+#include "asset_cache.h"
+#include "benchmark.h"
+#include "disk_color.h"
+#include "disk_sim.h"
+#include "exporter.h"
+#include "gl_ext.h"
+#include "job_system.h"
+#include "kerr_lens.h"
+#include "lens_shader.h"
+#include "line_geometry.h"
+#include "particle_kernel.h"
+#include "profiler.h"
+#include "quality.h"
+#include "scene_gen.h"
+#include "star_catalog.h"
+
+// Initial window size; the window is resizable and [F11] / --fullscreen
+// switch to a borderless window at the monitor's native resolution
 #define SCREEN_WIDTH 1280
 #define SCREEN_HEIGHT 720
 
-// Blackbody radiation color gradient for accretion disk
-// Based on Wien's displacement law: hotter regions emit shorter wavelengths
 const Color BG_COLOR = {0, 0, 0, 255};
-const Color DISK_HOT = {255, 255, 240, 255};      // ~10,000K - Near peak emission
-const Color DISK_MID = {255, 200, 100, 255};      // ~5,000K - Solar temperature
-const Color DISK_COLD = {200, 80, 30, 255};       // ~3,000K - Red dwarf range
-
-struct Star { float x, y, z, brightness; };
-struct Particle { float angle, radius, speed, yOffset; };
-
-// Distributes stars uniformly on a sphere using spherical coordinates
-// theta: azimuthal angle [0, 2π], phi: polar angle [0, π]
-std::vector<Star> CreateStars(int n) {
-    std::vector<Star> stars(n);
-    for (int i = 0; i < n; i++) {
-        float theta = GetRandomValue(0, 3600) * 0.1f * DEG2RAD;
-        float phi = GetRandomValue(0, 1800) * 0.1f * DEG2RAD;
-        float d = 50.0f + GetRandomValue(0, 50);
-        stars[i] = {d * sinf(phi) * cosf(theta), d * cosf(phi),
-                    d * sinf(phi) * sinf(theta), 0.5f + GetRandomValue(0, 50) * 0.01f};
-    }
-    return stars;
-}
-
-// Particle distribution weighted toward inner disk edge (t² bias)
-// Models higher density near ISCO where matter accumulates before plunging
-std::vector<Particle> CreateDisk(int n, float rIn, float rOut) {
-    std::vector<Particle> p(n);
-    for (int i = 0; i < n; i++) {
-        float t = GetRandomValue(0, 1000) * 0.001f;
-        t = t * t; // Quadratic bias toward inner edge
-        p[i].radius = rIn + t * (rOut - rIn);
-        p[i].angle = GetRandomValue(0, 3600) * 0.1f * DEG2RAD;
-        p[i].speed = 2.0f / sqrtf(p[i].radius); // Keplerian: v ∝ r^(-1/2)
-        p[i].yOffset = GetRandomValue(-50, 50) * 0.001f;
-    }
-    return p;
-}
-
-// Combines thermal emission color with relativistic Doppler shift
-// Doppler factor D affects both intensity (D³ beaming) and frequency (color shift)
-Color GetDiskColor(float t, float doppler) {
-    float r, g, b;
-
-    // Interpolate blackbody color based on radial temperature profile
-    // Inner disk ~10^7 K (X-ray), outer disk ~10^4 K (optical) - scaled for visualization
-    if (t < 0.3f) {
-        float f = t / 0.3f;
-        r = DISK_HOT.r + (DISK_MID.r - DISK_HOT.r) * f;
-        g = DISK_HOT.g + (DISK_MID.g - DISK_HOT.g) * f;
-        b = DISK_HOT.b + (DISK_MID.b - DISK_HOT.b) * f;
+
+// The disk color table (disk_color.h) on the GPU
+struct DiskColorLUT {
+    std::vector<Color> texels; // DISK_LUT_TEMP_SIZE * DISK_LUT_DOPPLER_SIZE, row-major by D
+    Texture2D texture = {0};
+    Texture2D hdrTexture = {0}; // Same table from GetDiskRadiance(), float and unclamped
+};
+
+DiskColorLUT LoadDiskColorLUT(const AssetCache& cache) {
+    DiskColorLUT lut;
+    lut.texels.resize(DISK_LUT_TEMP_SIZE * DISK_LUT_DOPPLER_SIZE);
+    std::vector<float> radiance;
+    const void* hdrTexels = nullptr;
+    std::string key = GetDiskColorLUTKey();
+    AssetDesc ldrDesc = {PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, DISK_LUT_TEMP_SIZE, DISK_LUT_DOPPLER_SIZE};
+    AssetDesc hdrDesc = {PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, DISK_LUT_TEMP_SIZE, DISK_LUT_DOPPLER_SIZE};
+    CachedAsset ldrCached, hdrCached;
+    if (LoadCachedAsset(cache, "disk_lut", key, ldrDesc, ldrCached) &&
+        LoadCachedAsset(cache, "disk_lut_hdr", key, hdrDesc, hdrCached)) {
+        memcpy(lut.texels.data(), ldrCached.data, ldrCached.layerSize);
+        hdrTexels = hdrCached.data;
+    } else {
+        UnloadCachedAsset(ldrCached);
+        FillDiskColorLUT(lut.texels, radiance);
+        hdrTexels = radiance.data();
+        SaveCachedAsset(cache, "disk_lut", key, ldrDesc, lut.texels.data());
+        SaveCachedAsset(cache, "disk_lut_hdr", key, hdrDesc, hdrTexels);
+    }
+
+    Image img = {lut.texels.data(), DISK_LUT_TEMP_SIZE, DISK_LUT_DOPPLER_SIZE, 1,
+                 PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    lut.texture = LoadTextureFromImage(img);
+    SetTextureFilter(lut.texture, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(lut.texture, TEXTURE_WRAP_CLAMP);
+
+    // Straight from the mapping on a cache hit
+    Image hdrImg = {(void*)hdrTexels, DISK_LUT_TEMP_SIZE, DISK_LUT_DOPPLER_SIZE, 1,
+                    PIXELFORMAT_UNCOMPRESSED_R32G32B32A32};
+    lut.hdrTexture = LoadTextureFromImage(hdrImg);
+    SetTextureFilter(lut.hdrTexture, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(lut.hdrTexture, TEXTURE_WRAP_CLAMP);
+    UnloadCachedAsset(ldrCached);
+    UnloadCachedAsset(hdrCached);
+    return lut;
+}
+
+void UnloadDiskColorLUT(DiskColorLUT& lut) {
+    UnloadTexture(lut.texture);
+    UnloadTexture(lut.hdrTexture);
+    lut = {};
+}
+
+// Binds the LUT on texture unit 0 for the line/particle shaders (sampler "diskLUT");
+// the float table when the scene target can hold values above 1
+void BindDiskColorLUT(const DiskColorLUT& lut, bool hdr) {
+    gl::ActiveTexture(gl::TEXTURE0);
+    gl::BindTexture(gl::TEXTURE_2D, hdr ? lut.hdrTexture.id : lut.texture.id);
+}
+
+// Schwarzschild deflection table: deflection angle α(b) of a photon with impact
+// parameter b (in units of Rs), from numerically integrated null geodesics.
+// Samples are spaced as b = bCrit + (bMax - bCrit)·x² to resolve the
+// logarithmic divergence at the photon capture radius bCrit = (3√3/2)·Rs.
+const int DEFLECTION_LUT_SIZE = 512;
+const float DEFLECTION_B_CRIT = 2.5980762f;
+const float DEFLECTION_B_MAX = 40.0f;      // 2nd-order weak field is within 0.2% beyond this
+// Lens-to-source over observer-to-source distance (D_ls / D_s) assumed for the scene
+const float LENS_SOURCE_RATIO = 0.5f;
+
+struct DeflectionLUT {
+    std::vector<float> alpha;   // Radians, texel i at x = (i + 0.5) / DEFLECTION_LUT_SIZE
+    Texture2D texture = {0};
+};
+
+// Orbit equation of a Schwarzschild null geodesic (Rs = 1, u = 1/r):
+//   d²u/dφ² = -u + 1.5·u²
+// Starts at infinity (u = 0, du/dφ = 1/b) and integrates with RK4 until the
+// photon escapes again (u crosses 0) or falls through the horizon (u >= 1).
+// Returns the total deflection Δφ - π, or -1 if captured.
+float IntegrateDeflection(float b) {
+    const double h = 2e-3;
+    const double PHI_MAX = 8.0 * PI; // Still winding the photon sphere: treat as captured
+    auto accel = [](double u) { return -u + 1.5 * u * u; };
+
+    double u = 0.0, w = 1.0 / b, phi = 0.0;
+    while (phi < PHI_MAX) {
+        double k1u = w,                k1w = accel(u);
+        double k2u = w + 0.5 * h * k1w, k2w = accel(u + 0.5 * h * k1u);
+        double k3u = w + 0.5 * h * k2w, k3w = accel(u + 0.5 * h * k2u);
+        double k4u = w + h * k3w,       k4w = accel(u + h * k3u);
+        double un = u + h / 6.0 * (k1u + 2.0 * k2u + 2.0 * k3u + k4u);
+        double wn = w + h / 6.0 * (k1w + 2.0 * k2w + 2.0 * k3w + k4w);
+
+        if (un >= 1.0) return -1.0f;
+        if (un < 0.0) {
+            // Interpolate the exact crossing inside the last step
+            double f = u / (u - un);
+            return (float)(phi + f * h - PI);
+        }
+        u = un;
+        w = wn;
+        phi += h;
+    }
+    return -1.0f;
+}
+
+DeflectionLUT LoadDeflectionLUT(const AssetCache& cache) {
+    DeflectionLUT lut;
+    lut.alpha.resize(DEFLECTION_LUT_SIZE);
+    std::string key = TextFormat("deflection v1 n=%d b=%.4f..%.2f", DEFLECTION_LUT_SIZE, DEFLECTION_B_CRIT, DEFLECTION_B_MAX);
+    AssetDesc desc = {PIXELFORMAT_UNCOMPRESSED_R32, DEFLECTION_LUT_SIZE, 1};
+    CachedAsset cached;
+    if (LoadCachedAsset(cache, "deflection", key, desc, cached)) {
+        memcpy(lut.alpha.data(), cached.data, cached.layerSize);
+        UnloadCachedAsset(cached);
     } else {
-        float f = (t - 0.3f) / 0.7f;
-        r = DISK_MID.r + (DISK_COLD.r - DISK_MID.r) * f;
-        g = DISK_MID.g + (DISK_COLD.g - DISK_MID.g) * f;
-        b = DISK_MID.b + (DISK_COLD.b - DISK_MID.b) * f;
-    }
-
-    // Relativistic beaming: observed intensity I_obs = I_emit * D³
-    // D > 1: approaching (blueshift), D < 1: receding (redshift)
-    float intensity = doppler * doppler * doppler;
-    intensity = fmaxf(0.3f, fminf(2.5f, intensity));
-
-    // Approximate frequency shift effect on RGB channels
-    // Real implementation would require spectral integration
-    if (doppler > 1.0f) {
-        float shift = (doppler - 1.0f) * 0.8f;
-        b = fminf(255.0f, b + 60.0f * shift);
-        g = fminf(255.0f, g + 30.0f * shift);
-        r = fmaxf(0.0f, r - 20.0f * shift);
+        for (int i = 0; i < DEFLECTION_LUT_SIZE; i++) {
+            float x = (i + 0.5f) / DEFLECTION_LUT_SIZE;
+            float b = DEFLECTION_B_CRIT + (DEFLECTION_B_MAX - DEFLECTION_B_CRIT) * x * x;
+            float alpha = IntegrateDeflection(b);
+            // Only the innermost texel can wind past PHI_MAX; clamp it to its neighbour's range
+            lut.alpha[i] = (alpha < 0.0f) ? 2.0f * PI : alpha;
+        }
+        SaveCachedAsset(cache, "deflection", key, desc, lut.alpha.data());
+    }
+
+    Image img = {lut.alpha.data(), DEFLECTION_LUT_SIZE, 1, 1, PIXELFORMAT_UNCOMPRESSED_R32};
+    lut.texture = LoadTextureFromImage(img);
+    SetTextureFilter(lut.texture, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(lut.texture, TEXTURE_WRAP_CLAMP);
+    TraceLog(LOG_INFO, "LENS: Deflection table α(%.2f Rs) = %.3f rad, α(%.0f Rs) = %.4f rad",
+             DEFLECTION_B_CRIT, lut.alpha.front(), DEFLECTION_B_MAX, lut.alpha.back());
+    return lut;
+}
+
+void UnloadDeflectionLUT(DeflectionLUT& lut) {
+    UnloadTexture(lut.texture);
+    lut = {};
+}
+
+struct LineMesh {
+    unsigned int vao = 0, vbo = 0;
+    LineGroup disk, einstein, photon, glow;
+};
+
+// Builds all static line geometry into a single VBO, one range per group and LOD level
+LineMesh LoadLineMesh(float bhRadius, float diskInner, float diskOuter) {
+    LineGeometry geo = BuildLineGeometry(bhRadius, diskInner, diskOuter);
+    const std::vector<LineVertex>& v = geo.vertices;
+    LineMesh mesh;
+    mesh.disk = geo.disk;
+    mesh.einstein = geo.einstein;
+    mesh.photon = geo.photon;
+    mesh.glow = geo.glow;
+
+    gl::GenVertexArrays(1, &mesh.vao);
+    gl::BindVertexArray(mesh.vao);
+    gl::GenBuffers(1, &mesh.vbo);
+    gl::BindBuffer(gl::ARRAY_BUFFER, mesh.vbo);
+    gl::BufferData(gl::ARRAY_BUFFER, v.size() * sizeof(LineVertex), v.data(), gl::STATIC_DRAW);
+
+    // Attribute slots follow raylib's defaults: 0 position, 1 texcoord, 3 color, 5 texcoord2
+    gl::VertexAttribPointer(0, 3, gl::FLOAT, false, sizeof(LineVertex), (void*)offsetof(LineVertex, x));
+    gl::EnableVertexAttribArray(0);
+    gl::VertexAttribPointer(1, 2, gl::FLOAT, false, sizeof(LineVertex), (void*)offsetof(LineVertex, phase));
+    gl::EnableVertexAttribArray(1);
+    gl::VertexAttribPointer(3, 4, gl::UNSIGNED_BYTE, true, sizeof(LineVertex), (void*)offsetof(LineVertex, r));
+    gl::EnableVertexAttribArray(3);
+    gl::VertexAttribPointer(5, 2, gl::FLOAT, false, sizeof(LineVertex), (void*)offsetof(LineVertex, lutT));
+    gl::EnableVertexAttribArray(5);
+
+    gl::BindVertexArray(0);
+    gl::BindBuffer(gl::ARRAY_BUFFER, 0);
+    return mesh;
+}
+
+void UnloadLineMesh(LineMesh& mesh) {
+    gl::DeleteBuffers(1, &mesh.vbo);
+    gl::DeleteVertexArrays(1, &mesh.vao);
+    mesh = {};
+}
+
+// `offsets` are the camera's positions relative to each of `count` holes; every
+// hole shares the mesh, so each group follows the hole whose ring is closest
+void UpdateLineMeshLOD(LineMesh& mesh, const Vector3* offsets, int count, float fovy, int height, float maxErrorPx) {
+    for (LineGroup* group : {&mesh.disk, &mesh.einstein, &mesh.photon, &mesh.glow}) {
+        float distance = 1e9f;
+        for (int i = 0; i < count; i++) {
+            float rho = sqrtf(offsets[i].x * offsets[i].x + offsets[i].z * offsets[i].z);
+            distance = fminf(distance, GetLineGroupDistance(*group, rho, offsets[i].y));
+        }
+        UpdateLineLOD(*group, distance, fovy, height, maxErrorPx);
+    }
+}
+
+// Caller must have the line shader bound (rlEnableShader); one instance per view
+void DrawLineRange(const LineMesh& mesh, LineRange range, int views) {
+    gl::BindVertexArray(mesh.vao);
+    gl::DrawArraysInstanced(gl::LINES, range.first, range.count, views);
+    gl::BindVertexArray(0);
+}
+
+// Draws the group at its current level of detail
+void DrawLineGroup(const LineMesh& mesh, const LineGroup& group, int views) {
+    DrawLineRange(mesh, group.lod[group.level], views);
+}
+
+// Particle counts for the disk particle paths
+// CPU: SoA state advanced by the SIMD kernel, streamed as one vec4 per particle
+// GPU: static attribute buffer, orbits and colors evaluated in particles.vs
+// Sim: the GPU count, with orbits integrated by disk_sim.comp (GL 4.3+)
+const int CPU_DISK_PARTICLES = 100000;
+const int GPU_DISK_PARTICLES = 1000000;
+// Summed particle alpha, so both paths give the disk the same brightness
+const float DISK_PARTICLE_FLUX = 40000.0f;
+
+// [P] / --particles: which path animates the disk
+enum ParticlePath { PARTICLES_GPU, PARTICLES_SIM, PARTICLES_CPU, PARTICLE_PATHS };
+const char* const PARTICLE_PATH_NAMES[PARTICLE_PATHS] = {"gpu", "sim", "cpu"};
+
+// The time uniform of every shader counts from the start of the current
+// epoch, GPU_TIME_EPOCH long, so the float never grows large enough to lose
+// the orbits' precision however long the app runs. The period is a whole
+// number of π, the period of the photon ring shimmer, so line.vs wraps without
+// a seam. Orbits carry over through a per-particle step: the angle gained in
+// one epoch as a 32-bit fraction of a turn, which particles.vs multiplies by
+// the epoch index in wrapping integer arithmetic, exactly.
+const double GPU_TIME_EPOCH = 256.0 * PI;  // About 13 minutes
+
+// Particle attributes uploaded verbatim as one vec4 per vertex (angle holds
+// θ0; the shader advances it from the time uniform), plus the epoch step
+struct ParticleBuffer {
+    unsigned int vao = 0, vbo = 0, stepVbo = 0;
+    int count = 0;
+};
+
+ParticleBuffer LoadParticleBuffer(const std::vector<Particle>& particles) {
+    static_assert(sizeof(Particle) == 4 * sizeof(float), "Particle must map to a vec4 attribute");
+
+    // speed·GPU_TIME_EPOCH in turns, wrapped to [0, 1) and scaled to 2^32
+    std::vector<unsigned int> steps(particles.size());
+    for (size_t i = 0; i < particles.size(); i++) {
+        double turns = (double)particles[i].speed * GPU_TIME_EPOCH / (2.0 * PI);
+        steps[i] = (unsigned int)(uint64_t)llround((turns - floor(turns)) * 4294967296.0);
+    }
+
+    ParticleBuffer buf;
+    buf.count = (int)particles.size();
+    gl::GenVertexArrays(1, &buf.vao);
+    gl::BindVertexArray(buf.vao);
+    gl::GenBuffers(1, &buf.vbo);
+    gl::BindBuffer(gl::ARRAY_BUFFER, buf.vbo);
+    gl::BufferData(gl::ARRAY_BUFFER, particles.size() * sizeof(Particle), particles.data(), gl::STATIC_DRAW);
+    gl::VertexAttribPointer(0, 4, gl::FLOAT, false, sizeof(Particle), (void*)0);
+    gl::EnableVertexAttribArray(0);
+    gl::GenBuffers(1, &buf.stepVbo);
+    gl::BindBuffer(gl::ARRAY_BUFFER, buf.stepVbo);
+    gl::BufferData(gl::ARRAY_BUFFER, steps.size() * sizeof(unsigned int), steps.data(), gl::STATIC_DRAW);
+    gl::VertexAttribIPointer(1, 1, gl::UNSIGNED_INT, sizeof(unsigned int), (void*)0);
+    gl::EnableVertexAttribArray(1);
+    gl::BindVertexArray(0);
+    gl::BindBuffer(gl::ARRAY_BUFFER, 0);
+    return buf;
+}
+
+void UnloadParticleBuffer(ParticleBuffer& buf) {
+    gl::DeleteBuffers(1, &buf.vbo);
+    gl::DeleteBuffers(1, &buf.stepVbo);
+    gl::DeleteVertexArrays(1, &buf.vao);
+    buf = {};
+}
+
+// CPU path: same layout, refilled every frame by UploadParticleStream
+ParticleBuffer LoadParticleStream(int count) {
+    static_assert(sizeof(ParticleVertex) == 4 * sizeof(float), "ParticleVertex must map to a vec4 attribute");
+
+    ParticleBuffer buf;
+    buf.count = count;
+    gl::GenVertexArrays(1, &buf.vao);
+    gl::BindVertexArray(buf.vao);
+    gl::GenBuffers(1, &buf.vbo);
+    gl::BindBuffer(gl::ARRAY_BUFFER, buf.vbo);
+    gl::BufferData(gl::ARRAY_BUFFER, count * sizeof(ParticleVertex), nullptr, gl::STREAM_DRAW);
+    gl::VertexAttribPointer(0, 4, gl::FLOAT, false, sizeof(ParticleVertex), (void*)0);
+    gl::EnableVertexAttribArray(0);
+    gl::BindVertexArray(0);
+    gl::BindBuffer(gl::ARRAY_BUFFER, 0);
+    return buf;
+}
+
+// Orphans the previous frame's storage so the upload never waits on its draw;
+// only the first `count` vertices are sent
+void UploadParticleStream(const ParticleBuffer& buf, const std::vector<ParticleVertex>& verts, int count) {
+    gl::BindBuffer(gl::ARRAY_BUFFER, buf.vbo);
+    gl::BufferData(gl::ARRAY_BUFFER, buf.count * sizeof(ParticleVertex), nullptr, gl::STREAM_DRAW);
+    gl::BufferSubData(gl::ARRAY_BUFFER, 0, count * sizeof(ParticleVertex), verts.data());
+    gl::BindBuffer(gl::ARRAY_BUFFER, 0);
+}
+
+// Caller must have the particle shader bound (rlEnableShader). Disks are
+// generated in random order, so any range is an even thinning of the whole
+void DrawParticleBuffer(const ParticleBuffer& buf, int first, int count, int views) {
+    gl::BindVertexArray(buf.vao);
+    gl::DrawArraysInstanced(gl::POINTS, first, std::max(0, std::min(count, buf.count - first)), views);
+    gl::BindVertexArray(0);
+}
+
+// Background star count; the point buffer path has no per-star CPU cost
+const int STAR_COUNT = 2500;
+// Cubemap face resolution for the baked starfield (~1 texel per screen pixel at 50° fov)
+const int STAR_CUBEMAP_SIZE = 1024;
+// A grown catalogue prefix is baked into the cubemap once it has held this
+// long, so a quality level that climbs over several frames costs one bake
+const float STAR_REBAKE_SETTLE_TIME = 0.2f;
+
+struct StarField {
+    unsigned int vao = 0, vbo = 0;
+    int count = 0;
+    int capacity = 0; // Catalogue fields: records uploaded so far
+};
+
+StarField LoadStarField(const std::vector<Star>& stars) {
+    static_assert(sizeof(Star) == 4 * sizeof(float), "Star must map to a vec4 attribute");
+
+    StarField field;
+    field.count = (int)stars.size();
+    gl::GenVertexArrays(1, &field.vao);
+    gl::BindVertexArray(field.vao);
+    gl::GenBuffers(1, &field.vbo);
+    gl::BindBuffer(gl::ARRAY_BUFFER, field.vbo);
+    gl::BufferData(gl::ARRAY_BUFFER, stars.size() * sizeof(Star), stars.data(), gl::STATIC_DRAW);
+    gl::VertexAttribPointer(0, 4, gl::FLOAT, false, sizeof(Star), (void*)0);
+    gl::EnableVertexAttribArray(0);
+    gl::BindVertexArray(0);
+    gl::BindBuffer(gl::ARRAY_BUFFER, 0);
+    return field;
+}
+
+// Catalogue stars are distance-less; they are drawn on a sphere of this radius
+const float STAR_CATALOG_DISTANCE = 75.0f;
+// Faintest magnitude drawn at the lowest render scale (naked-eye sky); full
+// scale goes down to StarCatalogOptions::magLimit
+const float STAR_MAG_LIMIT_MIN = 6.5f;
+
+// Empty until UpdateCatalogStarField uploads the first prefix
+StarField LoadCatalogStarField() {
+    StarField field;
+    gl::GenVertexArrays(1, &field.vao);
+    gl::GenBuffers(1, &field.vbo);
+    return field;
+}
+
+// Draws the first `count` records, growing the upload straight from the
+// mapping when the prefix gets longer. Shrinking only lowers the draw count,
+// so a limit that moves back and forth doesn't re-upload. True if it grew.
+bool UpdateCatalogStarField(StarField& field, const StarCatalog& cat, int count) {
+    field.count = count;
+    if (count <= field.capacity) return false;
+
+    gl::BindVertexArray(field.vao);
+    gl::BindBuffer(gl::ARRAY_BUFFER, field.vbo);
+    gl::BufferData(gl::ARRAY_BUFFER, (size_t)count * sizeof(StarRecord), cat.records, gl::STATIC_DRAW);
+    gl::VertexAttribPointer(0, 3, gl::FLOAT, false, sizeof(StarRecord), (void*)offsetof(StarRecord, dir));
+    gl::EnableVertexAttribArray(0);
+    gl::VertexAttribPointer(1, 2, gl::SHORT, false, sizeof(StarRecord), (void*)offsetof(StarRecord, magnitude));
+    gl::EnableVertexAttribArray(1);
+    gl::BindVertexArray(0);
+    gl::BindBuffer(gl::ARRAY_BUFFER, 0);
+    field.capacity = count;
+    return true;
+}
+
+void UnloadStarField(StarField& field) {
+    gl::DeleteBuffers(1, &field.vbo);
+    gl::DeleteVertexArrays(1, &field.vao);
+    field = {};
+}
+
+// Caller must have the star shader bound (rlEnableShader)
+void DrawStarField(const StarField& field, int views) {
+    gl::Enable(gl::PROGRAM_POINT_SIZE);
+    gl::BindVertexArray(field.vao);
+    gl::DrawArraysInstanced(gl::POINTS, 0, field.count, views);
+    gl::BindVertexArray(0);
+    gl::Disable(gl::PROGRAM_POINT_SIZE);
+}
+
+// Renders the point starfield into the six faces of a cubemap seen from the
+// origin. Stars sit at 50-100 units, so the parallax lost by treating them
+// as infinitely far while the camera orbits at <= 30 units is small.
+// Baked faces are cached under `key` (every parameter the field was built from);
+// an empty key always bakes
+TextureCubemap BakeStarCubemap(const StarField& field, Shader starShader, int mvpLoc, int size,
+                               const AssetCache& cache, const std::string& key) {
+    // Face order +X, -X, +Y, -Y, +Z, -Z with the usual GL cubemap up vectors
+    const Vector3 dirs[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    const Vector3 ups[6] = {{0, -1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}, {0, -1, 0}, {0, -1, 0}};
+
+    AssetDesc desc = {PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, size, size, 6};
+    CachedAsset cached;
+    bool hit = !key.empty() && LoadCachedAsset(cache, "star_cube", key, desc, cached);
+
+    TextureCubemap cube = {0, size, size, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    gl::GenTextures(1, &cube.id);
+    gl::BindTexture(gl::TEXTURE_CUBE_MAP, cube.id);
+    for (int face = 0; face < 6; face++) {
+        const void* texels = hit ? (const char*)cached.data + face * cached.layerSize : nullptr;
+        gl::TexImage2D(gl::TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, gl::RGBA8, size, size, 0,
+                       gl::RGBA, gl::UNSIGNED_BYTE, texels);
+    }
+    gl::TexParameteri(gl::TEXTURE_CUBE_MAP, gl::TEXTURE_MIN_FILTER, gl::LINEAR);
+    gl::TexParameteri(gl::TEXTURE_CUBE_MAP, gl::TEXTURE_MAG_FILTER, gl::LINEAR);
+    gl::TexParameteri(gl::TEXTURE_CUBE_MAP, gl::TEXTURE_WRAP_S, gl::CLAMP_TO_EDGE);
+    gl::TexParameteri(gl::TEXTURE_CUBE_MAP, gl::TEXTURE_WRAP_T, gl::CLAMP_TO_EDGE);
+    gl::TexParameteri(gl::TEXTURE_CUBE_MAP, gl::TEXTURE_WRAP_R, gl::CLAMP_TO_EDGE);
+    gl::BindTexture(gl::TEXTURE_CUBE_MAP, 0);
+    if (hit) {
+        UnloadCachedAsset(cached);
+        return cube;
+    }
+
+    // Faces are read back as they are drawn so the next start can skip the bake
+    std::vector<unsigned char> faces(key.empty() ? 0 : (size_t)size * size * 4 * 6);
+    gl::GLint viewport[4];
+    gl::GetIntegerv(gl::VIEWPORT, viewport);
+    unsigned int fbo = 0;
+    gl::GenFramebuffers(1, &fbo);
+    gl::BindFramebuffer(gl::FRAMEBUFFER, fbo);
+    gl::Viewport(0, 0, size, size);
+    gl::Disable(gl::DEPTH_TEST);
+
+    Matrix proj = MatrixPerspective(90.0 * DEG2RAD, 1.0, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    // Frames may have left the shader drawing a multi-view atlas
+    int oneView = 1;
+    SetShaderValue(starShader, GetShaderLocation(starShader, "viewCount"), &oneView, SHADER_UNIFORM_INT);
+    for (int face = 0; face < 6; face++) {
+        gl::FramebufferTexture2D(gl::FRAMEBUFFER, gl::COLOR_ATTACHMENT0,
+                                 gl::TEXTURE_CUBE_MAP_POSITIVE_X + face, cube.id, 0);
+        if (gl::CheckFramebufferStatus(gl::FRAMEBUFFER) != gl::FRAMEBUFFER_COMPLETE) {
+            TraceLog(LOG_WARNING, "STARS: Cubemap face %i framebuffer incomplete", face);
+        }
+        gl::ClearColor(0, 0, 0, 1);
+        gl::Clear(gl::COLOR_BUFFER_BIT);
+
+        Matrix view = MatrixLookAt({0, 0, 0}, dirs[face], ups[face]);
+        SetShaderValueMatrix(starShader, mvpLoc, MatrixMultiply(view, proj));
+        rlEnableShader(starShader.id);
+        DrawStarField(field, 1);
+        rlDisableShader();
+        if (!faces.empty()) {
+            gl::ReadPixels(0, 0, size, size, gl::RGBA, gl::UNSIGNED_BYTE, faces.data() + (size_t)face * size * size * 4);
+        }
+    }
+
+    gl::BindFramebuffer(gl::FRAMEBUFFER, 0);
+    gl::DeleteFramebuffers(1, &fbo);
+    gl::Viewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    TraceLog(LOG_INFO, "STARS: Baked %i stars into %ix%i cubemap", field.count, size, size);
+    if (!faces.empty()) SaveCachedAsset(cache, "star_cube", key, desc, faces.data());
+    return cube;
+}
+
+// Multi-view [--views N, --stereo]: N cameras rendered side by side into one
+// atlas the size of the frame. Simulation, LUTs and meshes are shared; every
+// scene draw is instanced once per view (atlasPosition() in line.vs squeezes
+// instance i into column i and clips it there), and the lensing pass runs once
+// over the whole atlas. Stereo is two parallel eyes STEREO_EYE_SEPARATION
+// apart; otherwise the views fan out, each turned by one column's field of view.
+const float STEREO_EYE_SEPARATION = 0.5f;  // World units, scaled with a hole group
+
+struct ViewOptions {
+    int count = 1;
+    bool stereo = false;
+};
+
+struct ViewSet {
+    int count = 1;
+    Camera3D cams[MAX_VIEWS];       // For projecting points into a column
+    Matrix view[MAX_VIEWS], proj[MAX_VIEWS];
+};
+
+// Cameras for the columns of a width x height atlas around `cam`
+ViewSet MakeViewSet(const ViewOptions& opts, const Camera3D& cam, int width, int height, float sceneScale) {
+    ViewSet set;
+    set.count = opts.count;
+    float aspect = (float)width / opts.count / height;
+    Vector3 forward = Vector3Subtract(cam.target, cam.position);
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, cam.up));
+    float columnFov = 2.0f * atanf(tanf(cam.fovy * DEG2RAD * 0.5f) * aspect);
+    for (int i = 0; i < set.count; i++) {
+        Camera3D c = cam;
+        float side = i - (set.count - 1) * 0.5f;  // Column offset from the centre
+        if (opts.stereo) {
+            Vector3 eye = Vector3Scale(right, side * STEREO_EYE_SEPARATION * sceneScale);
+            c.position = Vector3Add(cam.position, eye);
+            c.target = Vector3Add(cam.target, eye);
+        } else {
+            // Positive angles turn left about up; columns further right look further right
+            c.target = Vector3Add(cam.position, Vector3RotateByAxisAngle(forward, cam.up, -side * columnFov));
+        }
+        set.cams[i] = c;
+        set.view[i] = MatrixLookAt(c.position, c.target, c.up);
+        set.proj[i] = MatrixPerspective(c.fovy * DEG2RAD, aspect, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    }
+    return set;
+}
+
+// Sets a `uniform mat4 name[count]` (SetShaderValueMatrix only sets one)
+void SetShaderValueMatrices(Shader shader, int loc, const Matrix* m, int count) {
+    float data[MAX_VIEWS * 16];
+    for (int i = 0; i < count; i++) memcpy(data + 16 * i, MatrixToFloatV(m[i]).v, 16 * sizeof(float));
+    rlEnableShader(shader.id);
+    gl::UniformMatrix4fv(loc, count, false, data);
+}
+
+// Each view's mvp for a model matrix, and the column count the shader squeezes them into
+void SetShaderViews(Shader shader, int mvpLoc, int viewCountLoc, const ViewSet& views, Matrix model) {
+    Matrix mvp[MAX_VIEWS];
+    for (int i = 0; i < views.count; i++) mvp[i] = MatrixMultiply(model, MatrixMultiply(views.view[i], views.proj[i]));
+    SetShaderValueMatrices(shader, mvpLoc, mvp, views.count);
+    SetShaderValue(shader, viewCountLoc, &views.count, SHADER_UNIFORM_INT);
+}
+
+// Draws the baked starfield as one full-screen triangle per view (see skybox.vs)
+void DrawSkybox(TextureCubemap cube, Shader skyShader, int invViewProjLoc, int viewCountLoc, const ViewSet& views,
+                unsigned int emptyVao) {
+    Matrix invViewProj[MAX_VIEWS];
+    for (int i = 0; i < views.count; i++) {
+        Matrix view = views.view[i];
+        view.m12 = view.m13 = view.m14 = 0.0f; // Rotation only: sky at infinity
+        invViewProj[i] = MatrixInvert(MatrixMultiply(view, views.proj[i]));
+    }
+    SetShaderValueMatrices(skyShader, invViewProjLoc, invViewProj, views.count);
+    SetShaderValue(skyShader, viewCountLoc, &views.count, SHADER_UNIFORM_INT);
+
+    rlEnableShader(skyShader.id);
+    rlDisableDepthTest(); // Triangle sits on the far plane; everything draws over it
+    rlDisableDepthMask();
+    gl::ActiveTexture(gl::TEXTURE0);
+    gl::BindTexture(gl::TEXTURE_CUBE_MAP, cube.id);
+    gl::BindVertexArray(emptyVao);
+    gl::DrawArraysInstanced(gl::TRIANGLES, 0, 3, views.count);
+    gl::BindVertexArray(0);
+    gl::BindTexture(gl::TEXTURE_CUBE_MAP, 0);
+    rlEnableDepthMask();
+    rlEnableDepthTest();
+    rlDisableShader();
+}
+
+// Bloom chain: bright-pass + downsample to half res, further 2x downsamples,
+// separable blur on every level, then additive upsample back to level 0.
+// Level count sets the glow radius; per-pixel cost stays constant.
+const int BLOOM_LEVELS = 4;
+
+struct BloomChain {
+    RenderTexture2D down[BLOOM_LEVELS];   // Level i is (w >> (i+1)) x (h >> (i+1))
+    RenderTexture2D temp[BLOOM_LEVELS];   // Horizontal blur scratch, same sizes
+};
+
+struct BloomShaders {
+    Shader down, blur, up;
+    int downTexelLoc, downBrightLoc, blurDirLoc, upTexelLoc;
+};
+
+BloomShaders LoadBloomShaders() {
+    BloomShaders s;
+    s.down = LoadShader(0, "bloom_down.fs");
+    s.blur = LoadShader(0, "bloom_blur.fs");
+    s.up = LoadShader(0, "bloom_up.fs");
+    s.downTexelLoc = GetShaderLocation(s.down, "texelSize");
+    s.downBrightLoc = GetShaderLocation(s.down, "brightPass");
+    s.blurDirLoc = GetShaderLocation(s.blur, "direction");
+    s.upTexelLoc = GetShaderLocation(s.up, "texelSize");
+    return s;
+}
+
+void UnloadBloomShaders(BloomShaders& s) {
+    UnloadShader(s.down);
+    UnloadShader(s.blur);
+    UnloadShader(s.up);
+}
+
+// HDR scene targets: RGBA16F so D³ beaming and additive particle accumulation
+// keep values above 1 until the lensing pass tone maps them
+const int HDR_MSAA_SAMPLES = 4;
+
+// LoadRenderTexture() with a half-float color attachment. Unloads with
+// UnloadRenderTexture() like any other render texture.
+RenderTexture2D LoadRenderTextureHDR(int width, int height, bool depth) {
+    RenderTexture2D rt = {0};
+    rt.texture = {0, width, height, 1, PIXELFORMAT_UNCOMPRESSED_R16G16B16A16};
+    gl::GenTextures(1, &rt.texture.id);
+    gl::BindTexture(gl::TEXTURE_2D, rt.texture.id);
+    gl::TexImage2D(gl::TEXTURE_2D, 0, gl::RGBA16F, width, height, 0, gl::RGBA, gl::HALF_FLOAT, nullptr);
+    gl::TexParameteri(gl::TEXTURE_2D, gl::TEXTURE_MIN_FILTER, gl::LINEAR);
+    gl::TexParameteri(gl::TEXTURE_2D, gl::TEXTURE_MAG_FILTER, gl::LINEAR);
+    gl::TexParameteri(gl::TEXTURE_2D, gl::TEXTURE_WRAP_S, gl::CLAMP_TO_EDGE);
+    gl::TexParameteri(gl::TEXTURE_2D, gl::TEXTURE_WRAP_T, gl::CLAMP_TO_EDGE);
+    gl::BindTexture(gl::TEXTURE_2D, 0);
+
+    gl::GenFramebuffers(1, &rt.id);
+    gl::BindFramebuffer(gl::FRAMEBUFFER, rt.id);
+    gl::FramebufferTexture2D(gl::FRAMEBUFFER, gl::COLOR_ATTACHMENT0, gl::TEXTURE_2D, rt.texture.id, 0);
+    if (depth) {
+        rt.depth = {0, width, height, 1, 19}; // 19: raylib's depth pseudo-format
+        gl::GenRenderbuffers(1, &rt.depth.id);
+        gl::BindRenderbuffer(gl::RENDERBUFFER, rt.depth.id);
+        // 0 samples is plain single-sampled storage
+        gl::RenderbufferStorageMultisample(gl::RENDERBUFFER, 0, gl::DEPTH_COMPONENT24, width, height);
+        gl::FramebufferRenderbuffer(gl::FRAMEBUFFER, gl::DEPTH_ATTACHMENT, gl::RENDERBUFFER, rt.depth.id);
+        gl::BindRenderbuffer(gl::RENDERBUFFER, 0);
+    }
+    if (gl::CheckFramebufferStatus(gl::FRAMEBUFFER) != gl::FRAMEBUFFER_COMPLETE) {
+        TraceLog(LOG_WARNING, "HDR: %ix%i float framebuffer incomplete", width, height);
+    }
+    gl::BindFramebuffer(gl::FRAMEBUFFER, 0);
+    return rt;
+}
+
+// Multisampled HDR framebuffer for pass 1, resolved into a plain texture
+// before anything samples it. Only rt.id and the texture size are meaningful;
+// they are what BeginTextureMode() needs.
+struct MsaaTarget {
+    RenderTexture2D rt = {0};
+    unsigned int colorRb = 0, depthRb = 0;
+    int samples = 0;
+};
+
+MsaaTarget LoadMsaaTarget(int width, int height, int samples) {
+    MsaaTarget m;
+    gl::GLint maxSamples = 0;
+    gl::GetIntegerv(gl::MAX_SAMPLES, &maxSamples);
+    m.samples = samples < maxSamples ? samples : maxSamples;
+    if (m.samples < 2) return m; // Caller renders straight into the resolve target
+
+    m.rt.texture = {0, width, height, 1, PIXELFORMAT_UNCOMPRESSED_R16G16B16A16};
+    gl::GenRenderbuffers(1, &m.colorRb);
+    gl::BindRenderbuffer(gl::RENDERBUFFER, m.colorRb);
+    gl::RenderbufferStorageMultisample(gl::RENDERBUFFER, m.samples, gl::RGBA16F, width, height);
+    gl::GenRenderbuffers(1, &m.depthRb);
+    gl::BindRenderbuffer(gl::RENDERBUFFER, m.depthRb);
+    gl::RenderbufferStorageMultisample(gl::RENDERBUFFER, m.samples, gl::DEPTH_COMPONENT24, width, height);
+    gl::BindRenderbuffer(gl::RENDERBUFFER, 0);
+
+    gl::GenFramebuffers(1, &m.rt.id);
+    gl::BindFramebuffer(gl::FRAMEBUFFER, m.rt.id);
+    gl::FramebufferRenderbuffer(gl::FRAMEBUFFER, gl::COLOR_ATTACHMENT0, gl::RENDERBUFFER, m.colorRb);
+    gl::FramebufferRenderbuffer(gl::FRAMEBUFFER, gl::DEPTH_ATTACHMENT, gl::RENDERBUFFER, m.depthRb);
+    if (gl::CheckFramebufferStatus(gl::FRAMEBUFFER) != gl::FRAMEBUFFER_COMPLETE) {
+        TraceLog(LOG_WARNING, "HDR: %ix MSAA framebuffer incomplete, rendering without MSAA", m.samples);
+        gl::BindFramebuffer(gl::FRAMEBUFFER, 0);
+        gl::DeleteFramebuffers(1, &m.rt.id);
+        gl::DeleteRenderbuffers(1, &m.colorRb);
+        gl::DeleteRenderbuffers(1, &m.depthRb);
+        return {};
+    }
+    gl::BindFramebuffer(gl::FRAMEBUFFER, 0);
+    return m;
+}
+
+void UnloadMsaaTarget(MsaaTarget& m) {
+    if (m.rt.id) {
+        gl::DeleteFramebuffers(1, &m.rt.id);
+        gl::DeleteRenderbuffers(1, &m.colorRb);
+        gl::DeleteRenderbuffers(1, &m.depthRb);
+    }
+    m = {};
+}
+
+// Averages the samples of m into dst (same size)
+void ResolveMsaaTarget(const MsaaTarget& m, const RenderTexture2D& dst) {
+    int w = m.rt.texture.width, h = m.rt.texture.height;
+    gl::BindFramebuffer(gl::READ_FRAMEBUFFER, m.rt.id);
+    gl::BindFramebuffer(gl::DRAW_FRAMEBUFFER, dst.id);
+    gl::BlitFramebuffer(0, 0, w, h, 0, 0, w, h, gl::COLOR_BUFFER_BIT, gl::NEAREST);
+    gl::BindFramebuffer(gl::FRAMEBUFFER, 0);
+}
+
+// Sized from the scene target that feeds it (width x height); float levels
+// when the scene is HDR so bright values survive the blur
+BloomChain LoadBloomChain(int width, int height, bool hdr) {
+    BloomChain chain;
+    for (int i = 0; i < BLOOM_LEVELS; i++) {
+        int w = width >> (i + 1), h = height >> (i + 1);
+        if (w < 1) w = 1;
+        if (h < 1) h = 1;
+        chain.down[i] = hdr ? LoadRenderTextureHDR(w, h, false) : LoadRenderTexture(w, h);
+        chain.temp[i] = hdr ? LoadRenderTextureHDR(w, h, false) : LoadRenderTexture(w, h);
+        SetTextureFilter(chain.down[i].texture, TEXTURE_FILTER_BILINEAR);
+        SetTextureFilter(chain.temp[i].texture, TEXTURE_FILTER_BILINEAR);
+        SetTextureWrap(chain.down[i].texture, TEXTURE_WRAP_CLAMP);
+        SetTextureWrap(chain.temp[i].texture, TEXTURE_WRAP_CLAMP);
+    }
+    return chain;
+}
+
+void UnloadBloomChain(BloomChain& chain) {
+    for (int i = 0; i < BLOOM_LEVELS; i++) {
+        UnloadRenderTexture(chain.down[i]);
+        UnloadRenderTexture(chain.temp[i]);
+    }
+}
+
+// Draws src stretched over the whole of dst with the active shader.
+// Every render texture here shares the scene target's orientation, so the same
+// Y-flipped source rectangle is used for each hop.
+void DrawPass(Texture2D src, RenderTexture2D dst) {
+    BeginTextureMode(dst);
+    DrawTexturePro(src, {0, 0, (float)src.width, -(float)src.height},
+                   {0, 0, (float)dst.texture.width, (float)dst.texture.height}, {0, 0}, 0.0f, WHITE);
+    EndTextureMode();
+}
+
+// Runs the first `levels` of the chain on the scene; the result ends up in
+// chain.down[0]. Fewer levels skip the smallest (widest) ones.
+void ApplyBloom(const BloomChain& chain, const BloomShaders& s, Texture2D scene, int levels) {
+    // Downsample chain, bright-pass folded into the first step
+    BeginShaderMode(s.down);
+    for (int i = 0; i < levels; i++) {
+        Texture2D src = (i == 0) ? scene : chain.down[i - 1].texture;
+        float texel[2] = {1.0f / src.width, 1.0f / src.height};
+        int bright = (i == 0) ? 1 : 0;
+        SetShaderValue(s.down, s.downTexelLoc, texel, SHADER_UNIFORM_VEC2);
+        SetShaderValue(s.down, s.downBrightLoc, &bright, SHADER_UNIFORM_INT);
+        DrawPass(src, chain.down[i]);
+    }
+    EndShaderMode();
+
+    // Separable Gaussian at every (low) resolution
+    BeginShaderMode(s.blur);
+    for (int i = 0; i < levels; i++) {
+        Texture2D level = chain.down[i].texture;
+        float horizontal[2] = {1.0f / level.width, 0.0f};
+        float vertical[2] = {0.0f, 1.0f / level.height};
+        SetShaderValue(s.blur, s.blurDirLoc, horizontal, SHADER_UNIFORM_VEC2);
+        DrawPass(level, chain.temp[i]);
+        SetShaderValue(s.blur, s.blurDirLoc, vertical, SHADER_UNIFORM_VEC2);
+        DrawPass(chain.temp[i].texture, chain.down[i]);
+    }
+    EndShaderMode();
+
+    // Additive upsample from the smallest level back to half res
+    BeginShaderMode(s.up);
+    BeginBlendMode(BLEND_ADDITIVE);
+    for (int i = levels - 1; i > 0; i--) {
+        Texture2D src = chain.down[i].texture;
+        float texel[2] = {1.0f / src.width, 1.0f / src.height};
+        SetShaderValue(s.up, s.upTexelLoc, texel, SHADER_UNIFORM_VEC2);
+        DrawPass(src, chain.down[i - 1]);
+    }
+    EndBlendMode();
+    EndShaderMode();
+}
+
+const int LENS_MODELS = 3;          // Artistic, Schwarzschild table, Kerr map
+const float KERR_SPIN_STEP = 0.1f;  // Per press of [ or ]
+
+// Bounded lensing: outside this radius around the hole the lens moves the image
+// by less than LENS_BOUND_SHIFT_PX, and lensing.fs fades it out completely
+// towards the radius so the cheap lensing_lite.fs takes over without a seam
+const float LENS_BOUND_SHIFT_PX = 3.0f;
+
+// Radius in lensing.fs's dist units (screen heights), for a target `height` pixels tall
+float LensInfluenceRadius(int lensModel, float rs, float rsScreen, float lensScale, int height) {
+    float shift = LENS_BOUND_SHIFT_PX / height;
+    float radius, edge;
+    if (lensModel != 0) {
+        // Weak field α ≈ 2Rs/b shifts uv by α·lensScale; falls off slowly, so
+        // this usually covers the whole frame
+        radius = 2.0f * lensScale * rsScreen / shift;
+        edge = DEFLECTION_B_CRIT * rsScreen;
+    } else {
+        // Artistic falloff 1.5·rs²/dist²
+        radius = rs * sqrtf(1.5f / shift);
+        edge = rs;
+    }
+    // Inner glow reaches 2.5x the shadow edge
+    return fmaxf(radius, 2.5f * edge);
+}
+
+// Splits a width x height frame into `region` (pixels, top-down, clipped to
+// the frame) and up to four strips around it. Returns the number of strips
+// written to `outside`; `inside` may come back empty.
+int SplitLensRegion(int width, int height, Rectangle region, Rectangle& inside, Rectangle outside[4]) {
+    float x0 = fmaxf(0.0f, floorf(region.x)), x1 = fminf((float)width, ceilf(region.x + region.width));
+    float y0 = fmaxf(0.0f, floorf(region.y)), y1 = fminf((float)height, ceilf(region.y + region.height));
+    if (x0 >= x1 || y0 >= y1) {
+        inside = {0, 0, 0, 0};
+        outside[0] = {0, 0, (float)width, (float)height};
+        return 1;
+    }
+    inside = {x0, y0, x1 - x0, y1 - y0};
+    int n = 0;
+    if (y0 > 0) outside[n++] = {0, 0, (float)width, y0};
+    if (y1 < height) outside[n++] = {0, y1, (float)width, height - y1};
+    if (x0 > 0) outside[n++] = {0, y0, x0, y1 - y0};
+    if (x1 < width) outside[n++] = {x1, y0, width - x1, y1 - y0};
+    return n;
+}
+
+// Draws the part of a Y-flipped render texture under `r` (top-down pixels) 1:1
+void DrawTextureRegion(Texture2D tex, Rectangle r) {
+    DrawTexturePro(tex, {r.x, tex.height - r.y - r.height, r.width, -r.height}, r, {0, 0}, 0.0f, WHITE);
+}
+
+// Volumetric disk [V]: disk_volume.fs ray-marches the gas at 1/div of the
+// frame resolution into `color` (premultiplied radiance, opacity) and `depth`
+// (opacity-weighted path length); half-res marches are brought back to the
+// frame size by disk_volume_up.fs, which uses the depth to keep edges.
+// lensing.fs composites the result over the lensed scene.
+const int DISK_VOLUME_MODES = 3;   // Off, half resolution, full resolution
+
+struct DiskVolumeTarget {
+    int div = 0;                      // 0 when the volume is off
+    RenderTexture2D march = {0};      // Color attachment 0; depth is attachment 1
+    unsigned int depth = 0;
+    RenderTexture2D full = {0};       // Upsampled to the frame size (div 2 only)
+};
+
+DiskVolumeTarget LoadDiskVolumeTarget(int width, int height, int div) {
+    DiskVolumeTarget v;
+    v.div = div;
+    if (div == 0) return v;
+    int w = width / div, h = height / div;
+    v.march = LoadRenderTextureHDR(w, h, false);
+
+    gl::GenTextures(1, &v.depth);
+    gl::BindTexture(gl::TEXTURE_2D, v.depth);
+    gl::TexImage2D(gl::TEXTURE_2D, 0, gl::R16F, w, h, 0, gl::RED_FORMAT, gl::HALF_FLOAT, nullptr);
+    gl::TexParameteri(gl::TEXTURE_2D, gl::TEXTURE_MIN_FILTER, gl::NEAREST);
+    gl::TexParameteri(gl::TEXTURE_2D, gl::TEXTURE_MAG_FILTER, gl::NEAREST);
+    gl::TexParameteri(gl::TEXTURE_2D, gl::TEXTURE_WRAP_S, gl::CLAMP_TO_EDGE);
+    gl::TexParameteri(gl::TEXTURE_2D, gl::TEXTURE_WRAP_T, gl::CLAMP_TO_EDGE);
+    gl::BindTexture(gl::TEXTURE_2D, 0);
+
+    // Draw buffer state belongs to the framebuffer, so this is set once
+    const gl::GLenum buffers[2] = {gl::COLOR_ATTACHMENT0, gl::COLOR_ATTACHMENT1};
+    gl::BindFramebuffer(gl::FRAMEBUFFER, v.march.id);
+    gl::FramebufferTexture2D(gl::FRAMEBUFFER, gl::COLOR_ATTACHMENT1, gl::TEXTURE_2D, v.depth, 0);
+    gl::DrawBuffers(2, buffers);
+    if (gl::CheckFramebufferStatus(gl::FRAMEBUFFER) != gl::FRAMEBUFFER_COMPLETE) {
+        TraceLog(LOG_WARNING, "VOLUME: %ix%i march framebuffer incomplete", w, h);
+    }
+    gl::BindFramebuffer(gl::FRAMEBUFFER, 0);
+
+    if (div > 1) v.full = LoadRenderTextureHDR(width, height, false);
+    return v;
+}
+
+void UnloadDiskVolumeTarget(DiskVolumeTarget& v) {
+    if (v.div == 0) return;
+    UnloadRenderTexture(v.march);
+    gl::DeleteTextures(1, &v.depth);
+    if (v.full.id) UnloadRenderTexture(v.full);
+    v = {};
+}
+
+// What lensing.fs samples: the upsampled copy for half-res marches
+Texture2D GetDiskVolumeTexture(const DiskVolumeTarget& v) {
+    return v.full.id ? v.full.texture : v.march.texture;
+}
+
+struct DiskVolumeShaders {
+    Shader march, up;
+    int invViewProjLoc, cameraPosLoc, epochLoc, timeLoc, upSourceSizeLoc, upDepthLoc;
+};
+
+DiskVolumeShaders LoadDiskVolumeShaders(float diskInner, float diskOuter, const float lutDopplerRange[2]) {
+    DiskVolumeShaders s;
+    s.march = LoadShader("skybox.vs", "disk_volume.fs");
+    s.up = LoadShader(0, "disk_volume_up.fs");
+    s.invViewProjLoc = GetShaderLocation(s.march, "invViewProj");
+    s.cameraPosLoc = GetShaderLocation(s.march, "cameraPos");
+    s.epochLoc = GetShaderLocation(s.march, "epoch");
+    s.timeLoc = GetShaderLocation(s.march, "time");
+    s.upSourceSizeLoc = GetShaderLocation(s.up, "sourceSize");
+    s.upDepthLoc = GetShaderLocation(s.up, "volumeDepth");
+    int lutUnit = 0;
+    SetShaderValue(s.march, GetShaderLocation(s.march, "diskInner"), &diskInner, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(s.march, GetShaderLocation(s.march, "diskOuter"), &diskOuter, SHADER_UNIFORM_FLOAT);
+    float epochLength = (float)GPU_TIME_EPOCH;
+    SetShaderValue(s.march, GetShaderLocation(s.march, "epochLength"), &epochLength, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(s.march, GetShaderLocation(s.march, "diskLUT"), &lutUnit, SHADER_UNIFORM_INT);
+    SetShaderValue(s.march, GetShaderLocation(s.march, "lutDopplerRange"), lutDopplerRange, SHADER_UNIFORM_VEC2);
+    return s;
+}
+
+void UnloadDiskVolumeShaders(DiskVolumeShaders& s) {
+    UnloadShader(s.march);
+    UnloadShader(s.up);
+}
+
+// Marches the disk for the camera given by view/proj and upsamples it if
+// needed. The disk LUT must be bound (BindDiskColorLUT). Blending is off:
+// every pixel is overwritten, opacity included. `epoch` and `time` are the
+// clock as particles.vs takes it.
+void DrawDiskVolume(const DiskVolumeTarget& v, const DiskVolumeShaders& s, Matrix view, Matrix proj,
+                    Vector3 cameraPos, int epoch, float time, unsigned int emptyVao) {
+    view.m12 = view.m13 = view.m14 = 0.0f; // skybox.vs wants directions only
+    SetShaderValueMatrix(s.march, s.invViewProjLoc, MatrixInvert(MatrixMultiply(view, proj)));
+    SetShaderValue(s.march, s.cameraPosLoc, &cameraPos, SHADER_UNIFORM_VEC3);
+    SetShaderValue(s.march, s.epochLoc, &epoch, SHADER_UNIFORM_INT);
+    SetShaderValue(s.march, s.timeLoc, &time, SHADER_UNIFORM_FLOAT);
+
+    rlDrawRenderBatchActive();
+    gl::Disable(gl::BLEND);
+    BeginTextureMode(v.march);
+    rlEnableShader(s.march.id);
+    rlDisableDepthTest();
+    gl::BindVertexArray(emptyVao);
+    gl::DrawArrays(gl::TRIANGLES, 0, 3);
+    gl::BindVertexArray(0);
+    rlEnableDepthTest();
+    rlDisableShader();
+    EndTextureMode();
+
+    if (v.full.id) {
+        float sourceSize[2] = {(float)v.march.texture.width, (float)v.march.texture.height};
+        Texture2D depth = {v.depth, v.march.texture.width, v.march.texture.height, 1, PIXELFORMAT_UNCOMPRESSED_R16};
+        SetShaderValue(s.up, s.upSourceSizeLoc, sourceSize, SHADER_UNIFORM_VEC2);
+        SetShaderValueTexture(s.up, s.upDepthLoc, depth);
+        BeginShaderMode(s.up);
+        DrawPass(v.march.texture, v.full);
+        EndShaderMode();
+    }
+    gl::Enable(gl::BLEND);
+}
+
+// Offscreen targets at the internal render resolution: pass 1 scene, bloom
+// chain and, when rendering below native size, the lensed frame to upscale.
+// With hdr the scene and bloom chain are RGBA16F and pass 1 draws into a
+// multisampled buffer that is resolved into `scene`; the lensed frame is
+// already tone mapped and stays 8-bit.
+struct FrameTargets {
+    int width = 0, height = 0;
+    bool hdr = false;
+    bool multisample = false;     // Requested; msaa.rt.id stays 0 if the driver refused
+    RenderTexture2D scene = {0};
+    MsaaTarget msaa;
+    RenderTexture2D lensed = {0};
+    BloomChain bloom;
+    DiskVolumeTarget volume;
+};
+
+// MSAA only applies to the float scene; TAA [T] turns it off
+FrameTargets LoadFrameTargets(int width, int height, bool hdr, bool multisample, int volumeDiv) {
+    FrameTargets t;
+    t.width = width;
+    t.height = height;
+    t.hdr = hdr;
+    t.multisample = multisample;
+    // Bilinear so the bloom taps and FXAA's fractional offsets filter as intended
+    if (hdr) {
+        if (multisample) t.msaa = LoadMsaaTarget(width, height, HDR_MSAA_SAMPLES);
+        t.scene = LoadRenderTextureHDR(width, height, t.msaa.rt.id == 0);
     } else {
-        float shift = (1.0f - doppler) * 1.2f;
-        r = fminf(255.0f, r + 40.0f * shift);
-        g = fmaxf(0.0f, g - 30.0f * shift);
-        b = fmaxf(0.0f, b - 60.0f * shift);
+        t.scene = LoadRenderTexture(width, height);
+        SetTextureFilter(t.scene.texture, TEXTURE_FILTER_BILINEAR);
+        SetTextureWrap(t.scene.texture, TEXTURE_WRAP_CLAMP);
+    }
+    t.lensed = LoadRenderTexture(width, height);
+    SetTextureFilter(t.lensed.texture, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(t.lensed.texture, TEXTURE_WRAP_CLAMP);
+    t.bloom = LoadBloomChain(width, height, hdr);
+    t.volume = LoadDiskVolumeTarget(width, height, volumeDiv);
+    return t;
+}
+
+// Where pass 1 draws: the multisampled buffer if there is one
+RenderTexture2D GetSceneDrawTarget(const FrameTargets& t) {
+    return t.msaa.rt.id ? t.msaa.rt : t.scene;
+}
+
+void UnloadFrameTargets(FrameTargets& t) {
+    UnloadRenderTexture(t.scene);
+    UnloadMsaaTarget(t.msaa);
+    UnloadRenderTexture(t.lensed);
+    UnloadBloomChain(t.bloom);
+    UnloadDiskVolumeTarget(t.volume);
+    t = {};
+}
+
+// Temporal anti-aliasing [T]: the projection is offset by a Halton (2, 3)
+// sequence of sub-pixel jitters, and taa.fs accumulates the lensed frames into
+// ping-pong float history buffers at the output resolution
+const int TAA_JITTER_PHASES = 8;
+
+float Halton(int index, int base) {
+    float f = 1.0f, r = 0.0f;
+    for (int i = index; i > 0; i /= base) {
+        f /= base;
+        r += f * (i % base);
+    }
+    return r;
+}
+
+// Offset in render-target pixels, within ±0.5
+Vector2 GetTaaJitter(uint64_t frame) {
+    int i = (int)(frame % TAA_JITTER_PHASES) + 1;
+    return {Halton(i, 2) - 0.5f, Halton(i, 3) - 0.5f};
+}
+
+struct TaaHistory {
+    int width = 0, height = 0;
+    RenderTexture2D buffer[2] = {};
+    int current = 0;                   // Holds the latest resolve
+    bool valid = false;
+    Matrix prevViewProj = {};          // Unjittered view-projection of the latest resolve
+};
+
+TaaHistory LoadTaaHistory(int width, int height) {
+    TaaHistory h;
+    h.width = width;
+    h.height = height;
+    for (RenderTexture2D& b : h.buffer) b = LoadRenderTextureHDR(width, height, false);
+    return h;
+}
+
+void UnloadTaaHistory(TaaHistory& h) {
+    for (RenderTexture2D& b : h.buffer) UnloadRenderTexture(b);
+    h = {};
+}
+
+// Dynamic resolution: scale applied to pass 1 and the lensing/bloom passes,
+// set by [R] or by the quality governor in Auto
+const float RENDER_SCALE_MIN = 0.5f;
+const float RENDER_SCALE_MAX = 1.0f;
+
+// Size the frame is rendered for. A window resize is only followed once the
+// new size has held for RESIZE_SETTLE_TIME, so dragging a border reallocates
+// the targets once rather than every frame; until then the current frame is
+// stretched to the window. A minimised window keeps the last size.
+const float RESIZE_SETTLE_TIME = 0.2f;
+
+struct OutputSize {
+    int width = SCREEN_WIDTH, height = SCREEN_HEIGHT;
+    int pendingW = 0, pendingH = 0;
+    float pendingTime = 0.0f;
+};
+
+void UpdateOutputSize(OutputSize& out, int windowW, int windowH, float dt) {
+    if (windowW <= 0 || windowH <= 0 || IsWindowMinimized()) return;
+    if (windowW == out.width && windowH == out.height) {
+        out.pendingW = out.pendingH = 0;
+        return;
+    }
+    if (windowW != out.pendingW || windowH != out.pendingH) {
+        out.pendingW = windowW;
+        out.pendingH = windowH;
+        out.pendingTime = 0.0f;
+    }
+    out.pendingTime += dt;
+    if (out.pendingTime >= RESIZE_SETTLE_TIME) {
+        TraceLog(LOG_INFO, "WINDOW: Output %dx%d -> %dx%d", out.width, out.height, windowW, windowH);
+        out.width = windowW;
+        out.height = windowH;
+        out.pendingW = out.pendingH = 0;
     }
+}
+
+// Catalogue magnitude limit for the current quality level: the render scale
+// picks a point between STAR_MAG_LIMIT_MIN and the configured limit
+float GetStarMagLimit(const StarCatalogOptions& opts, float renderScale) {
+    float q = (renderScale - RENDER_SCALE_MIN) / (RENDER_SCALE_MAX - RENDER_SCALE_MIN);
+    float maxLimit = fmaxf(opts.magLimit, STAR_MAG_LIMIT_MIN);
+    return STAR_MAG_LIMIT_MIN + (maxLimit - STAR_MAG_LIMIT_MIN) * fminf(fmaxf(q, 0.0f), 1.0f);
+}
+
+// Fixed-rate simulation clock. Camera, disk orbits and shader time advance in
+// SIM_DT steps and the renderer draws the state interpolated between the last
+// two, so a hitch no longer jumps the disk and the render rate doesn't change
+// what is simulated
+const int SIM_HZ = 120;
+const double SIM_DT = 1.0 / SIM_HZ;
+// Longer stalls are dropped rather than caught up, so one slow frame can't snowball
+const int SIM_MAX_STEPS = 8;
+
+// Several black holes [--holes N]: N equal masses spaced evenly on a circle in
+// the disk plane, each with its own disk. The circle is wide enough that the
+// disks never overlap, and turns at the rate a ring of N point masses orbits at
+// (sped up: at the true rate a binary takes minutes per orbit). One hole sits
+// still at the origin, as the scene always had it.
+const int HOLES_DEFAULT = 1;
+const float HOLE_SPACING = 1.1f;        // Neighbouring holes' separation, in disk diameters
+const float HOLE_GM = 0.5f;             // GM in Rs units (Rs = 2GM)
+const float HOLE_ORBIT_SPEEDUP = 20.0f;
+
+struct HoleRing {
+    int count = 1;
+    float radius = 0.0f;  // Orbit radius
+    float omega = 0.0f;   // Angular velocity, radians per time unit
+};
+
+HoleRing MakeHoleRing(int count, float diskOuter) {
+    HoleRing ring;
+    ring.count = count;
+    if (count < 2) return ring;
+    ring.radius = HOLE_SPACING * diskOuter / sinf(PI / count);
+    // Pull on one hole from the other N - 1 towards the centre: Σ 1 / (4 R² sin(πk/N))
+    float pull = 0.0f;
+    for (int k = 1; k < count; k++) pull += 0.25f / sinf(PI * k / count);
+    ring.omega = sqrtf(HOLE_GM * pull / (ring.radius * ring.radius * ring.radius)) * HOLE_ORBIT_SPEEDUP;
+    return ring;
+}
+
+Vector3 GetHolePosition(const HoleRing& ring, int index, double time) {
+    if (ring.count < 2) return {0.0f, 0.0f, 0.0f};
+    float a = (float)(ring.omega * time) + 2.0f * PI * index / ring.count;
+    return {cosf(a) * ring.radius, 0.0f, sinf(a) * ring.radius};
+}
+
+struct SimState {
+    double time = 0.0;
+    float camAngle = 0.0f, camElev = 0.2f, camDist = 16.0f;
+};
+
+struct SimClock {
+    double accumulator = 0.0;
+    uint64_t steps = 0;
+};
+
+// Number of steps due after a frame of frameTime seconds
+int AdvanceSimClock(SimClock& clock, double frameTime) {
+    clock.accumulator += frameTime;
+    // The epsilon keeps frame times that are exact multiples of SIM_DT from
+    // alternating between n - 1 and n + 1 steps through rounding
+    int steps = (int)(clock.accumulator / SIM_DT + 1e-6);
+    clock.accumulator = fmax(0.0, clock.accumulator - steps * SIM_DT);
+    steps = std::min(steps, SIM_MAX_STEPS);
+    clock.steps += steps;
+    return steps;
+}
+
+// Where the frame falls between the previous step (0) and the latest one (1)
+float GetSimAlpha(const SimClock& clock) {
+    return (float)fmin(1.0, clock.accumulator / SIM_DT);
+}
 
-    r = fminf(255.0f, r * intensity);
-    g = fminf(255.0f, g * intensity);
-    b = fminf(255.0f, b * intensity);
+SimState LerpSimState(const SimState& a, const SimState& b, float t) {
+    return {a.time + (b.time - a.time) * t, a.camAngle + (b.camAngle - a.camAngle) * t,
+            a.camElev + (b.camElev - a.camElev) * t, a.camDist + (b.camDist - a.camDist) * t};
+}
 
-    return {(unsigned char)r, (unsigned char)g, (unsigned char)b, 255};
+// --benchmark [--warmup N] [--json PATH], or --export PATH [--size WxH] [--fps N];
+// --frames N sets the length of either run, --hdr starts with the float scene target,
+// --seed N picks the star field and disk; --stars PATH [--star-mag M] renders a
+// star catalogue, --convert-stars CSV PATH builds one and exits; --spin A sets the
+// Kerr parameter of lens model 2; --cache DIR moves the asset cache, --no-cache disables it;
+// --taa starts with temporal anti-aliasing and creates the window without MSAA;
+// --frame-budget MS starts the quality governor (Auto) holding that frame time;
+// --fullscreen opens borderless at the monitor's resolution; --lens-stages LIST
+// picks the optional lensing stages (fxaa,bloom,chromatic,contrast, all or none);
+// --holes N puts N black holes in orbit around each other (1 to MAX_HOLES);
+// --views N renders N fanned-out views side by side (1 to MAX_VIEWS), --stereo two eyes;
+// --particles gpu|sim|cpu picks the disk particle path
+bool ParseCommandLine(int argc, char** argv, BenchmarkOptions& bench, ExportOptions& exp, bool& hdr, bool& taa,
+                      bool& fullscreen, uint64_t& seed, StarCatalogOptions& stars, float& spin, AssetCacheOptions& cache,
+                      QualityGovernor& quality, unsigned& lensStages, int& holes, ViewOptions& views, int& particles) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--benchmark") {
+            bench.enabled = true;
+        } else if (arg == "--hdr") {
+            hdr = true;
+        } else if (arg == "--taa") {
+            taa = true;
+        } else if (arg == "--fullscreen") {
+            fullscreen = true;
+        } else if (arg == "--warmup" && hasValue) {
+            bench.warmup = std::max(0, atoi(argv[++i]));
+        } else if (arg == "--json" && hasValue) {
+            bench.jsonPath = argv[++i];
+        } else if (arg == "--export" && hasValue) {
+            exp.enabled = true;
+            exp.path = argv[++i];
+        } else if (arg == "--size" && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &exp.width, &exp.height) != 2 || exp.width <= 0 || exp.height <= 0) {
+                TraceLog(LOG_ERROR, "ARGS: --size expects WIDTHxHEIGHT, got %s", argv[i]);
+                return false;
+            }
+        } else if (arg == "--fps" && hasValue) {
+            exp.fps = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--frames" && hasValue) {
+            bench.frames = exp.frames = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--stars" && hasValue) {
+            stars.path = argv[++i];
+        } else if (arg == "--star-mag" && hasValue) {
+            stars.magLimit = (float)atof(argv[++i]);
+        } else if (arg == "--convert-stars" && i + 2 < argc) {
+            stars.convertFrom = argv[++i];
+            stars.path = argv[++i];
+        } else if (arg == "--cache" && hasValue) {
+            cache.dir = argv[++i];
+        } else if (arg == "--no-cache") {
+            cache.dir.clear();
+        } else if (arg == "--spin" && hasValue) {
+            spin = std::clamp((float)atof(argv[++i]), 0.0f, KERR_SPIN_MAX);
+        } else if (arg == "--frame-budget" && hasValue) {
+            quality.enabled = true;
+            quality.budgetMs = fmaxf((float)atof(argv[++i]), 1.0f);
+        } else if (arg == "--lens-stages" && hasValue) {
+            if (!ParseLensStages(argv[++i], lensStages)) {
+                TraceLog(LOG_ERROR, "ARGS: --lens-stages expects fxaa,bloom,chromatic,contrast, all or none, got %s", argv[i]);
+                return false;
+            }
+        } else if (arg == "--holes" && hasValue) {
+            holes = atoi(argv[++i]);
+            if (holes < 1 || holes > MAX_HOLES) {
+                TraceLog(LOG_ERROR, "ARGS: --holes expects 1 to %d, got %s", MAX_HOLES, argv[i]);
+                return false;
+            }
+        } else if (arg == "--views" && hasValue) {
+            views.count = atoi(argv[++i]);
+            if (views.count < 1 || views.count > MAX_VIEWS) {
+                TraceLog(LOG_ERROR, "ARGS: --views expects 1 to %d, got %s", MAX_VIEWS, argv[i]);
+                return false;
+            }
+        } else if (arg == "--stereo") {
+            views.stereo = true;
+        } else if (arg == "--particles" && hasValue) {
+            std::string name = argv[++i];
+            particles = (int)(std::find(PARTICLE_PATH_NAMES, PARTICLE_PATH_NAMES + PARTICLE_PATHS, name) - PARTICLE_PATH_NAMES);
+            if (particles == PARTICLE_PATHS) {
+                TraceLog(LOG_ERROR, "ARGS: --particles expects gpu, sim or cpu, got %s", argv[i]);
+                return false;
+            }
+        } else if (arg == "--seed" && hasValue) {
+            char* end = nullptr;
+            seed = strtoull(argv[++i], &end, 0);
+            if (!end || *end) {
+                TraceLog(LOG_ERROR, "ARGS: --seed expects an integer, got %s", argv[i]);
+                return false;
+            }
+        } else {
+            TraceLog(LOG_ERROR, "ARGS: Unrecognised argument %s", arg.c_str());
+            TraceLog(LOG_INFO, "ARGS: Usage: %s [--benchmark [--warmup N] [--json PATH] | --export PATH "
+                     "[--size WxH] [--fps N]] [--frames N] [--hdr] [--taa] [--fullscreen] [--seed N] [--spin A] [--cache DIR | --no-cache] "
+                     "[--frame-budget MS] [--lens-stages LIST] [--holes N] [--views N | --stereo] [--particles P] [--stars PATH [--star-mag M]] | --convert-stars CSV PATH", argv[0]);
+            return false;
+        }
+    }
+    if (bench.enabled && exp.enabled) {
+        TraceLog(LOG_ERROR, "ARGS: --benchmark and --export cannot be combined");
+        return false;
+    }
+    if (views.stereo) views.count = 2;
+    // The TAA reprojection assumes one camera over the whole frame
+    if (views.count > 1 && taa) {
+        TraceLog(LOG_WARNING, "ARGS: --taa is ignored with several views");
+        taa = false;
+    }
+    // Scripted runs must render the same frames on every machine
+    if ((bench.enabled || exp.enabled) && quality.enabled) {
+        TraceLog(LOG_WARNING, "ARGS: --frame-budget is ignored by --benchmark and --export");
+        quality.enabled = false;
+    }
+    return true;
 }
 
-int main() {
-    SetConfigFlags(FLAG_MSAA_4X_HINT); // Hardware MSAA before window creation
+int main(int argc, char** argv) {
+    BenchmarkRun bench;
+    ExportOptions exportOpts;
+    bool hdrScene = false;
+    bool taa = false;
+    bool fullscreen = false;
+    uint64_t sceneSeed = SCENE_SEED_DEFAULT;
+    StarCatalogOptions catalogOpts;
+    float spin = 0.0f;
+    AssetCacheOptions cacheOpts;
+    QualityGovernor quality;
+    unsigned lensStages = LENS_STAGES_ALL;
+    int holeCount = HOLES_DEFAULT;
+    ViewOptions viewOpts;
+    int particlePath = PARTICLES_GPU;
+    if (!ParseCommandLine(argc, argv, bench.opts, exportOpts, hdrScene, taa, fullscreen, sceneSeed, catalogOpts, spin, cacheOpts,
+                          quality, lensStages, holeCount, viewOpts, particlePath)) {
+        return 1;
+    }
+    bench.seed = sceneSeed;
+    bench.holes = holeCount;
+    bench.views = viewOpts.count;
+    bench.stereo = viewOpts.stereo;
+    bench.lensStages = FormatLensStages(lensStages & (taa ? ~LENS_FXAA : LENS_STAGES_ALL));
+    if (!catalogOpts.convertFrom.empty()) return ConvertStarCatalog(catalogOpts.convertFrom, catalogOpts.path) ? 0 : 1;
+
+    // Generated tables and baked textures are mapped from here when their key matches
+    AssetCache cache;
+    OpenAssetCache(cache, cacheOpts);
+
+    // Mapped before the window opens; only the drawn prefix is ever paged in
+    StarCatalog catalog;
+    if (!catalogOpts.path.empty() && !OpenStarCatalog(catalog, catalogOpts.path)) return 1;
+    bool scripted = bench.opts.enabled || exportOpts.enabled;
+
+    // Benchmark runs render unthrottled in a fixed-size hidden window; exports
+    // keep the window as a preview but are not throttled either
+    // Hardware MSAA before window creation; a TAA run doesn't pay for it
+    unsigned int flags = taa ? 0 : FLAG_MSAA_4X_HINT;
+    if (bench.opts.enabled) flags |= FLAG_WINDOW_HIDDEN;
+    if (!scripted) flags |= FLAG_WINDOW_RESIZABLE;
+    SetConfigFlags(flags);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "GARGANTUA - Gravitational Lensing");
-    SetTargetFPS(60);
+    SetTargetFPS(scripted ? 0 : 60);
+    SetWindowMinSize(320, 180);
+    if (fullscreen && !scripted) ToggleBorderlessWindowed();
+    // What the frame is rendered for; follows the window once a resize settles
+    OutputSize output;
+    output.width = GetScreenWidth();
+    output.height = GetScreenHeight();
+
+    if (!gl::LoadExtensions()) {
+        TraceLog(LOG_ERROR, "GL: Failed to resolve required OpenGL 3.3 entry points");
+        CloseWindow();
+        return 1;
+    }
 
     // Post-process shader handles gravitational lensing in screen-space
-    // More efficient than true ray-tracing through curved spacetime
-    Shader lensShader = LoadShader(0, "lensing.fs");
+    // More efficient than true ray-tracing through curved spacetime. Every
+    // permutation of its optional stages, and of lensing_lite.fs for bounded
+    // mode, is compiled here; each frame draws with the one it needs
+    LensShaders lensShaders = LoadLensShaders();
 
-    int resLoc = GetShaderLocation(lensShader, "resolution");
-    int bhPosLoc = GetShaderLocation(lensShader, "blackHolePos");
-    int bhRadLoc = GetShaderLocation(lensShader, "blackHoleRadius");
-    int timeLoc = GetShaderLocation(lensShader, "time");
+    // Static ring geometry shader; only the photon sphere flicker is animated
+    Shader lineShader = LoadShader("line.vs", "line.fs");
+    int lineMvpLoc = GetShaderLocation(lineShader, "mvp");
+    int lineTimeLoc = GetShaderLocation(lineShader, "time");
+    int lineViewsLoc = GetShaderLocation(lineShader, "viewCount");
 
-    // Offscreen render target for two-pass rendering pipeline
-    RenderTexture2D sceneRT = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    // Disk colors come from one shared LUT (CPU array + texture on unit 0)
+    DiskColorLUT diskLUT = LoadDiskColorLUT(cache);
+    float lutDopplerRange[2] = {DISK_LUT_DOPPLER_MIN, DISK_LUT_DOPPLER_MAX};
+    int lutUnit = 0;
+    SetShaderValue(lineShader, GetShaderLocation(lineShader, "diskLUT"), &lutUnit, SHADER_UNIFORM_INT);
+    SetShaderValue(lineShader, GetShaderLocation(lineShader, "lutDopplerRange"), lutDopplerRange, SHADER_UNIFORM_VEC2);
+
+    // GPU particle path: Keplerian orbit and Doppler color computed per vertex
+    Shader particleShader = LoadShader("particles.vs", "line.fs");
+    int partMvpLoc = GetShaderLocation(particleShader, "mvp");
+    int partTimeLoc = GetShaderLocation(particleShader, "time");
+    int partEpochLoc = GetShaderLocation(particleShader, "epoch");
+    int partInnerLoc = GetShaderLocation(particleShader, "diskInner");
+    int partOuterLoc = GetShaderLocation(particleShader, "diskOuter");
+    int partAlphaLoc = GetShaderLocation(particleShader, "particleAlpha");
+    int partViewsLoc = GetShaderLocation(particleShader, "viewCount");
+    SetShaderValue(particleShader, GetShaderLocation(particleShader, "diskLUT"), &lutUnit, SHADER_UNIFORM_INT);
+    SetShaderValue(particleShader, GetShaderLocation(particleShader, "lutDopplerRange"), lutDopplerRange, SHADER_UNIFORM_VEC2);
+
+    // Simulated particle path: disk_sim.comp integrates, particles_sim.vs draws its buffer
+    DiskSim diskSim = LoadDiskSim("disk_sim.comp");
+    Shader simParticleShader = LoadShader("particles_sim.vs", "line.fs");
+    int simPartMvpLoc = GetShaderLocation(simParticleShader, "mvp");
+    int simPartLeadLoc = GetShaderLocation(simParticleShader, "lead");
+    int simPartInnerLoc = GetShaderLocation(simParticleShader, "diskInner");
+    int simPartAlphaLoc = GetShaderLocation(simParticleShader, "particleAlpha");
+    int simPartViewsLoc = GetShaderLocation(simParticleShader, "viewCount");
+    SetShaderValue(simParticleShader, GetShaderLocation(simParticleShader, "diskLUT"), &lutUnit, SHADER_UNIFORM_INT);
+    SetShaderValue(simParticleShader, GetShaderLocation(simParticleShader, "lutDopplerRange"), lutDopplerRange, SHADER_UNIFORM_VEC2);
+    if (particlePath == PARTICLES_SIM && !diskSim.supported) {
+        TraceLog(LOG_WARNING, "PARTICLES: Simulated disk needs GL 4.3 compute shaders, using the CPU path");
+        particlePath = PARTICLES_CPU;
+    }
+    bench.particles = PARTICLE_PATH_NAMES[particlePath];
+
+    // CPU particle path: orbit and Doppler factor from particle_kernel.cpp
+    Shader cpuParticleShader = LoadShader("particles_cpu.vs", "line.fs");
+    int cpuPartMvpLoc = GetShaderLocation(cpuParticleShader, "mvp");
+    int cpuPartViewsLoc = GetShaderLocation(cpuParticleShader, "viewCount");
+    SetShaderValue(cpuParticleShader, GetShaderLocation(cpuParticleShader, "diskLUT"), &lutUnit, SHADER_UNIFORM_INT);
+    SetShaderValue(cpuParticleShader, GetShaderLocation(cpuParticleShader, "lutDopplerRange"), lutDopplerRange, SHADER_UNIFORM_VEC2);
+
+    // Static starfield: point sprites, or the same points baked into a skybox cubemap
+    Shader starShader = LoadShader("stars.vs", "stars.fs");
+    int starMvpLoc = GetShaderLocation(starShader, "mvp");
+    int starSizeLoc = GetShaderLocation(starShader, "pointSize");
+    Shader catalogShader = LoadShader("stars_catalog.vs", "stars.fs");
+    int catalogMvpLoc = GetShaderLocation(catalogShader, "mvp");
+    int catalogMagLimitLoc = GetShaderLocation(catalogShader, "magLimit");
+    SetShaderValue(catalogShader, GetShaderLocation(catalogShader, "starDistance"), &STAR_CATALOG_DISTANCE,
+                   SHADER_UNIFORM_FLOAT);
+    Shader skyShader = LoadShader("skybox.vs", "skybox.fs");
+    int skyInvVpLoc = GetShaderLocation(skyShader, "invViewProj");
+    int skySamplerLoc = GetShaderLocation(skyShader, "skybox");
+    int skyViewsLoc = GetShaderLocation(skyShader, "viewCount");
+    int skyUnit = 0;
+    SetShaderValue(skyShader, skySamplerLoc, &skyUnit, SHADER_UNIFORM_INT);
+
+    // Geodesic deflection table for the physically based lens model; the Kerr
+    // map (lensModel 2) is built once the job system is up. Constant uniforms
+    // go to every permutation
+    DeflectionLUT deflection = LoadDeflectionLUT(cache);
+    float deflectionRange[2] = {DEFLECTION_B_CRIT, DEFLECTION_B_MAX};
+    for (const LensProgram& p : lensShaders.lens) {
+        SetShaderValue(p.shader, p.deflectionRangeLoc, deflectionRange, SHADER_UNIFORM_VEC2);
+        SetShaderValue(p.shader, p.kerrExtentLoc, &KERR_MAP_EXTENT, SHADER_UNIFORM_FLOAT);
+    }
+
+    // Bounded mode: everything outside the lens region only needs bloom + tone mapping
+    bool boundedLens = false;
+
+    // Offscreen render targets for two-pass rendering pipeline, at the internal
+    // render resolution; the bloom chain lives alongside and follows its size
+    BloomShaders bloomShaders = LoadBloomShaders();
+    float manualScale = RENDER_SCALE_MAX;
+    FrameTargets targets = LoadFrameTargets(output.width, output.height, hdrScene, !taa, 0);
+
+    // Reduced-resolution frames are resampled to the backbuffer here
+    Shader upscaleShader = LoadShader(0, "upscale.fs");
+    int upTexelLoc = GetShaderLocation(upscaleShader, "sourceTexel");
+    int upSharpLoc = GetShaderLocation(upscaleShader, "sharpness");
+    bool sharpen = true;
+
+    // TAA resolve, from the lensed frame into the history at the output resolution
+    Shader taaShader = LoadShader(0, "taa.fs");
+    int taaHistoryLoc = GetShaderLocation(taaShader, "history");
+    int taaTexelLoc = GetShaderLocation(taaShader, "sourceTexel");
+    int taaJitterLoc = GetShaderLocation(taaShader, "jitter");
+    int taaInvViewProjLoc = GetShaderLocation(taaShader, "invViewProj");
+    int taaPrevViewProjLoc = GetShaderLocation(taaShader, "prevViewProj");
+    int taaCameraPosLoc = GetShaderLocation(taaShader, "cameraPos");
+    int taaValidLoc = GetShaderLocation(taaShader, "historyValid");
+    int taaDiskOuterLoc = GetShaderLocation(taaShader, "diskOuter");
+    TaaHistory taaHistory;
 
     Camera3D cam = {0};
     cam.position = {0.0f, 2.5f, 16.0f};
@@ -116,204 +1465,708 @@ int main() {
 
     // Schwarzschild radius Rs = 2GM/c² (normalized to 1.0)
     const float BH_RADIUS = 1.0f;
-    // ISCO (Innermost Stable Circular Orbit) = 3Rs for non-rotating black hole
+    // ISCO (Innermost Stable Circular Orbit) = 3Rs for non-rotating black hole;
+    // the Kerr model moves the inner edge to the prograde ISCO of its spin
     const float DISK_INNER = 2.5f;
     const float DISK_OUTER = 9.0f;
+    float diskInner = DISK_INNER;
 
-    auto stars = CreateStars(2500);
-    auto disk = CreateDisk(2000, DISK_INNER, DISK_OUTER);
+    // Every hole draws the same rings and its own share of the disk particles;
+    // the camera orbits the whole group at the distance it would one disk
+    HoleRing holes = MakeHoleRing(holeCount, DISK_OUTER);
+    float sceneScale = (holes.radius + DISK_OUTER) / DISK_OUTER;
+    if (holeCount > 1) TraceLog(LOG_INFO, "SCENE: %d black holes, orbit radius %.1f", holeCount, holes.radius);
+    // taa.fs reprojects everything inside this radius as disk plane or hole
+    float taaDiskOuter = DISK_OUTER * sceneScale;
+    SetShaderValue(taaShader, taaDiskOuterLoc, &taaDiskOuter, SHADER_UNIFORM_FLOAT);
 
-    float camAngle = 0.0f, camElev = 0.2f, camDist = 16.0f;
+    // Optional ray-marched thick disk in place of the rings and particles
+    DiskVolumeShaders volumeShaders = LoadDiskVolumeShaders(DISK_INNER, DISK_OUTER, lutDopplerRange);
+    int diskVolume = 0; // 0: rings and particles, 1: volume at half resolution, 2: full resolution
+
+    JobSystem jobs;
+    StartJobSystem(jobs);
+    TraceLog(LOG_INFO, "SCENE: Seed 0x%llx", (unsigned long long)sceneSeed);
+
+    // Spin changes rebuild it in the background, slice by slice
+    KerrLensMap kerr;
+    LoadKerrLensMap(kerr, jobs, cache, spin, DISK_OUTER);
+
+    // Random star field, or the catalogue prefix for the current quality level
+    bool useCatalog = catalog.count > 0;
+    Shader starDrawShader = useCatalog ? catalogShader : starShader;
+    int starDrawMvpLoc = useCatalog ? catalogMvpLoc : starMvpLoc;
+    int starDrawViewsLoc = GetShaderLocation(starDrawShader, "viewCount");
+    float starMagLimit = GetStarMagLimit(catalogOpts, RENDER_SCALE_MAX);
+    StarField stars;
+    if (useCatalog) {
+        stars = LoadCatalogStarField();
+        UpdateCatalogStarField(stars, catalog, CountStarsBrighterThan(catalog, starMagLimit));
+        SetShaderValue(catalogShader, catalogMagLimitLoc, &starMagLimit, SHADER_UNIFORM_FLOAT);
+    } else {
+        stars = LoadStarField(CreateStars(jobs, STAR_COUNT, sceneSeed));
+    }
+    float starSize = 1.5f;
+    SetShaderValue(starShader, starSizeLoc, &starSize, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(catalogShader, GetShaderLocation(catalogShader, "pointSize"), &starSize, SHADER_UNIFORM_FLOAT);
+    // Only the startup bake is cached: later catalogue rebakes would stall on the readback.
+    // Bump the versions when stars.vs/.fs or stars_catalog.vs change
+    std::string starCubeKey =
+        useCatalog ? TextFormat("catalog v1 %s n=%d/%d mag=%.2f size=%d point=%.2f", catalogOpts.path.c_str(), stars.count,
+                                catalog.count, starMagLimit, STAR_CUBEMAP_SIZE, starSize)
+                   : TextFormat("stars v1 seed=%llx n=%d size=%d point=%.2f", (unsigned long long)sceneSeed, STAR_COUNT,
+                                STAR_CUBEMAP_SIZE, starSize);
+    TextureCubemap starCube = BakeStarCubemap(stars, starDrawShader, starDrawMvpLoc, STAR_CUBEMAP_SIZE, cache, starCubeKey);
+    bool starCubeStale = false;     // The prefix grew since the last bake
+    float starCubeSettle = 0.0f;    // Seconds the grown prefix has held
+    unsigned int emptyVao = 0; // Core profile needs a bound VAO even without attributes
+    gl::GenVertexArrays(1, &emptyVao);
+    ParticleSoA cpuDisk = LoadParticleSoA(
+        CreateDisk(jobs, CPU_DISK_PARTICLES, DISK_INNER, DISK_OUTER, sceneSeed, RNG_STREAM_CPU_DISK), DISK_INNER, 0.4f, 1.8f);
+    // Double-buffered: workers fill one while the frame uploads the other
+    std::vector<ParticleVertex> cpuDiskVerts[2] = {std::vector<ParticleVertex>(cpuDisk.count),
+                                                   std::vector<ParticleVertex>(cpuDisk.count)};
+    int cpuDiskFront = 0;
+    int cpuDiskCounts[2] = {0, 0};  // Prefix each buffer was filled to, per the quality level
+    bool cpuDiskInFlight = false;
+    JobGroup cpuDiskJobs;
+    ParticleBuffer cpuDiskStream = LoadParticleStream(cpuDisk.count);
+    TraceLog(LOG_INFO, "PARTICLES: %d CPU particles, %s kernel", cpuDisk.count, GetParticleKernelName());
+    LineMesh lines = LoadLineMesh(BH_RADIUS, DISK_INNER, DISK_OUTER);
+    // The simulated disk starts from the GPU path's disk, at rest in the same orbits
+    std::vector<Particle> gpuDiskParticles = CreateDisk(jobs, GPU_DISK_PARTICLES, DISK_INNER, DISK_OUTER, sceneSeed, RNG_STREAM_GPU_DISK);
+    ParticleBuffer gpuDisk = LoadParticleBuffer(gpuDiskParticles);
+    ResetDiskSim(diskSim, gpuDiskParticles);
+    gpuDiskParticles = {};
+    // Per-step noise of the simulation, fixed by the scene seed like the disk itself
+    unsigned int diskSimSeed = (unsigned int)(sceneSeed ^ (sceneSeed >> 32));
+
+    SetShaderValue(particleShader, partInnerLoc, &DISK_INNER, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(particleShader, partOuterLoc, &DISK_OUTER, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(simParticleShader, simPartInnerLoc, &DISK_INNER, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(simParticleShader, GetShaderLocation(simParticleShader, "diskOuter"), &DISK_OUTER, SHADER_UNIFORM_FLOAT);
+    // Keep total disk brightness roughly constant as the drawn particle count
+    // changes; set per frame, since the quality level thins the disk
+    int cpuPartAlphaLoc = GetShaderLocation(cpuParticleShader, "particleAlpha");
+    SetShaderValue(cpuParticleShader, GetShaderLocation(cpuParticleShader, "diskInner"), &DISK_INNER, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(cpuParticleShader, GetShaderLocation(cpuParticleShader, "diskOuter"), &DISK_OUTER, SHADER_UNIFORM_FLOAT);
+
+    // Regenerates every disk representation for a new inner edge; the seeds
+    // are unchanged, so only the radial layout moves
+    auto rebuildDisk = [&](float inner) {
+        WaitJobGroup(jobs, cpuDiskJobs);
+        cpuDiskInFlight = false;
+        diskInner = inner;
+        cpuDisk = LoadParticleSoA(
+            CreateDisk(jobs, CPU_DISK_PARTICLES, inner, DISK_OUTER, sceneSeed, RNG_STREAM_CPU_DISK), inner, 0.4f, 1.8f);
+        UnloadLineMesh(lines);
+        lines = LoadLineMesh(BH_RADIUS, inner, DISK_OUTER);
+        UnloadParticleBuffer(gpuDisk);
+        std::vector<Particle> particles = CreateDisk(jobs, GPU_DISK_PARTICLES, inner, DISK_OUTER, sceneSeed, RNG_STREAM_GPU_DISK);
+        gpuDisk = LoadParticleBuffer(particles);
+        ResetDiskSim(diskSim, particles);
+        SetShaderValue(particleShader, partInnerLoc, &inner, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(simParticleShader, simPartInnerLoc, &inner, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(cpuParticleShader, GetShaderLocation(cpuParticleShader, "diskInner"), &inner, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(volumeShaders.march, GetShaderLocation(volumeShaders.march, "diskInner"), &inner, SHADER_UNIFORM_FLOAT);
+    };
+
+    SimClock simClock;
+    SimState sim, simPrev;
     bool autoRot = true;
-    float time = 0.0f;
-
-    while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
-        time += dt;
-
-        // Orbital camera controls
-        if (IsKeyDown(KEY_A)) camAngle -= dt;
-        if (IsKeyDown(KEY_D)) camAngle += dt;
-        if (IsKeyDown(KEY_W)) camElev = fminf(camElev + dt * 0.5f, 1.2f);
-        if (IsKeyDown(KEY_S)) camElev = fmaxf(camElev - dt * 0.5f, -0.3f);
-        if (IsKeyDown(KEY_Q)) camDist = fmaxf(camDist - dt * 4.0f, 6.0f);
-        if (IsKeyDown(KEY_E)) camDist = fminf(camDist + dt * 4.0f, 30.0f);
-        if (IsKeyPressed(KEY_SPACE)) autoRot = !autoRot;
-        if (autoRot) camAngle += dt * 0.12f;
+    bool bakedStars = false;
+    int lensModel = 0; // 0: artistic falloff, 1: geodesic deflection table, 2: Kerr map
+
+    Profiler profiler = LoadProfiler();
+    bool showProfiler = false;
+    int profileDumps = 0;
+
+    FrameExporter exporter;
+    if (exportOpts.enabled && !StartExport(exporter, exportOpts)) {
+        StopJobSystem(jobs);
+        CloseWindow();
+        return 1;
+    }
+
+    // Warmup frames hold the path's start pose, so the measured frames fly the
+    // same path whatever --warmup is
+    int scriptedWarmup = exportOpts.enabled ? 0 : bench.opts.warmup;
+    int scriptedPath = exportOpts.enabled ? exportOpts.frames : bench.opts.frames;
+    int scriptedTotal = scriptedWarmup + scriptedPath;
+    float scriptedDt = exportOpts.enabled ? 1.0f / exportOpts.fps : BENCHMARK_DT;
+    while (!WindowShouldClose() && (!scripted || (int)profiler.frame < scriptedTotal)) {
+        BeginProfileFrame(profiler);
+        BeginProfilePass(profiler, PASS_INPUT);
+
+        float dt = scripted ? scriptedDt : GetFrameTime();
+        int simSteps = AdvanceSimClock(simClock, dt);
+
+        // Orbital camera controls, held keys integrated per simulation step;
+        // benchmark and export follow the scripted path instead
+        const float h = (float)SIM_DT;
+        for (int i = 0; i < simSteps; i++) {
+            simPrev = sim;
+            sim.time += SIM_DT;
+            if (scripted) continue;
+            if (IsKeyDown(KEY_A)) sim.camAngle -= h;
+            if (IsKeyDown(KEY_D)) sim.camAngle += h;
+            if (IsKeyDown(KEY_W)) sim.camElev = fminf(sim.camElev + h * 0.5f, 1.2f);
+            if (IsKeyDown(KEY_S)) sim.camElev = fmaxf(sim.camElev - h * 0.5f, -0.3f);
+            if (IsKeyDown(KEY_Q)) sim.camDist = fmaxf(sim.camDist - h * 4.0f, 6.0f);
+            if (IsKeyDown(KEY_E)) sim.camDist = fminf(sim.camDist + h * 4.0f, 30.0f);
+            if (autoRot) sim.camAngle += h * 0.12f;
+        }
+        float simAlpha = GetSimAlpha(simClock);
+        SimState view = LerpSimState(simPrev, sim, simAlpha);
+        int epoch = (int)floor(view.time / GPU_TIME_EPOCH);  // Shader clock, see GPU_TIME_EPOCH
+        float epochTime = (float)(view.time - epoch * GPU_TIME_EPOCH);
+
+        if (scripted) {
+            GetBenchmarkCamera(std::max(0, (int)profiler.frame - scriptedWarmup), scriptedPath, view.camAngle, view.camElev,
+                               view.camDist);
+        } else {
+            if (IsKeyPressed(KEY_SPACE)) autoRot = !autoRot;
+            if (IsKeyPressed(KEY_P)) {
+                particlePath = (particlePath + 1) % PARTICLE_PATHS;
+                if (particlePath == PARTICLES_SIM && !diskSim.supported) particlePath = PARTICLES_CPU;
+            }
+            if (IsKeyPressed(KEY_B)) bakedStars = !bakedStars;
+            if (IsKeyPressed(KEY_L)) lensModel = (lensModel + 1) % LENS_MODELS;
+            if (IsKeyPressed(KEY_LEFT_BRACKET)) spin = fmaxf(spin - KERR_SPIN_STEP, 0.0f);
+            if (IsKeyPressed(KEY_RIGHT_BRACKET)) spin = fminf(spin + KERR_SPIN_STEP, KERR_SPIN_MAX);
+            if (IsKeyPressed(KEY_G)) boundedLens = !boundedLens;
+            if (IsKeyPressed(KEY_F)) sharpen = !sharpen;
+            if (IsKeyPressed(KEY_H)) hdrScene = !hdrScene;
+            if (IsKeyPressed(KEY_T) && viewOpts.count == 1) taa = !taa;
+            // disk_volume.fs marches a single disk around the origin, for a single view
+            if (IsKeyPressed(KEY_V) && holeCount == 1 && viewOpts.count == 1) {
+                diskVolume = (diskVolume + 1) % DISK_VOLUME_MODES;
+            }
+            if (IsKeyPressed(KEY_F1)) showProfiler = !showProfiler;
+            if (IsKeyPressed(KEY_F11)) ToggleBorderlessWindowed();
+            if (IsKeyPressed(KEY_F2)) DumpProfilerCSV(profiler, TextFormat("profile_%03d.csv", profileDumps++));
+            if (IsKeyPressed(KEY_R)) {
+                // Cycle 100% -> 75% -> 50% -> Auto -> 100%; Auto hands every knob to the governor
+                if (quality.enabled) {
+                    quality.enabled = false;
+                    manualScale = 1.0f;
+                    ResetQualityGovernor(quality);
+                } else if (manualScale > 0.75f) {
+                    manualScale = 0.75f;
+                } else if (manualScale > 0.5f) {
+                    manualScale = 0.5f;
+                } else {
+                    quality.enabled = true;
+                    ResetQualityGovernor(quality);
+                }
+            }
+        }
 
         // Spherical coordinate camera positioning
-        cam.position.x = cosf(camAngle) * camDist * cosf(camElev);
-        cam.position.y = sinf(camElev) * camDist * 0.4f + 1.5f;
-        cam.position.z = sinf(camAngle) * camDist * cosf(camElev);
+        cam.position.x = cosf(view.camAngle) * view.camDist * cosf(view.camElev);
+        cam.position.y = sinf(view.camElev) * view.camDist * 0.4f + 1.5f;
+        cam.position.z = sinf(view.camAngle) * view.camDist * cosf(view.camElev);
+        cam.position = Vector3Scale(cam.position, sceneScale);
+        Vector3 holePos[MAX_HOLES];
+        for (int i = 0; i < holeCount; i++) holePos[i] = GetHolePosition(holes, i, view.time);
+
+        // Kerr map follows the spin asynchronously; the disk follows the map, so
+        // the ISCO only moves once the lensing that goes with it is on screen
+        RequestKerrLensMap(kerr, spin);
+        UpdateKerrLensMap(kerr, jobs);
+        float wantInner = lensModel == 2 ? GetKerrIsco(kerr.spin) : DISK_INNER;
+        if (wantInner != diskInner) rebuildDisk(wantInner);
+
+        // Quality knobs for this frame, from the previous frames' measured work;
+        // the offscreen targets are rebuilt here, between frames, when the window
+        // size, scale or MSAA moves (every target they own is released first)
+        UpdateQualityGovernor(quality, profiler, dt);
+        const QualityLevel& level = GetQualityLevel(quality);
+        // Lensing stages: the requested set less what the level sheds; TAA replaces FXAA
+        unsigned stages = lensStages & level.lensStages & (taa ? ~LENS_FXAA : LENS_STAGES_ALL);
+        const LensProgram& lens = GetLensProgram(lensShaders, stages);
+        const LiteProgram& lite = GetLiteProgram(lensShaders, stages);
+        float renderScale = quality.enabled ? level.renderScale : manualScale;
+        if (!scripted) UpdateOutputSize(output, GetScreenWidth(), GetScreenHeight(), dt);
+        // Exports render at their own resolution, independent of the window. Scaled
+        // sizes are kept even; at full scale an odd window is matched exactly so
+        // the frame still goes straight to the backbuffer
+        auto scaled = [renderScale](int size) {
+            return renderScale < 1.0f ? std::max((int)(size * renderScale) & ~1, 2) : size;
+        };
+        int renderW = exportOpts.enabled ? exportOpts.width : scaled(output.width);
+        int renderH = exportOpts.enabled ? exportOpts.height : scaled(output.height);
+        int volumeDiv = diskVolume == 1 ? 2 : diskVolume == 2 ? 1 : 0;
+        bool multisample = !taa && level.msaa;
+        if (renderW != targets.width || renderH != targets.height || hdrScene != targets.hdr ||
+            multisample != targets.multisample || volumeDiv != targets.volume.div) {
+            UnloadFrameTargets(targets);
+            targets = LoadFrameTargets(renderW, renderH, hdrScene, multisample, volumeDiv);
+        }
+        // TAA always resolves from the lensed target, and its history is what gets shown
+        // Mid-resize the window no longer matches the targets and is stretched to
+        int screenW = GetScreenWidth(), screenH = GetScreenHeight();
+        bool resample = taa || exportOpts.enabled || renderW != screenW || renderH != screenH;
+        int outputW = exportOpts.enabled ? exportOpts.width : output.width;
+        int outputH = exportOpts.enabled ? exportOpts.height : output.height;
+        if (taa && (taaHistory.width != outputW || taaHistory.height != outputH)) {
+            UnloadTaaHistory(taaHistory);
+            taaHistory = LoadTaaHistory(outputW, outputH);
+        } else if (!taa && taaHistory.width) {
+            UnloadTaaHistory(taaHistory);
+        }
+        Vector2 jitter = taa ? GetTaaJitter(profiler.frame) : Vector2{0.0f, 0.0f};
+
+        // Ring tessellation from the projected size at the render resolution
+        Vector3 holeOffsets[MAX_HOLES];
+        for (int i = 0; i < holeCount; i++) holeOffsets[i] = Vector3Subtract(cam.position, holePos[i]);
+        UpdateLineMeshLOD(lines, holeOffsets, holeCount, cam.fovy * DEG2RAD, renderH,
+                          LINE_LOD_MAX_ERROR_PX * level.lodErrorScale);
+
+        // Catalogue prefix follows the quality level. When it reaches further
+        // than it has before, the cubemap keeps the old bake until the prefix
+        // has held for STAR_REBAKE_SETTLE_TIME; points mode draws it at once
+        if (useCatalog) {
+            starMagLimit = GetStarMagLimit(catalogOpts, renderScale);
+            SetShaderValue(catalogShader, catalogMagLimitLoc, &starMagLimit, SHADER_UNIFORM_FLOAT);
+            if (UpdateCatalogStarField(stars, catalog, CountStarsBrighterThan(catalog, starMagLimit))) {
+                starCubeStale = true;
+                starCubeSettle = 0.0f;
+            } else if (starCubeStale && (starCubeSettle += dt) >= STAR_REBAKE_SETTLE_TIME) {
+                UnloadTexture(starCube);
+                starCube = BakeStarCubemap(stars, catalogShader, catalogMvpLoc, STAR_CUBEMAP_SIZE, cache, "");
+                starCubeStale = false;
+            }
+        }
+        EndProfilePass(profiler);
 
         // Update disk particle orbits (Keplerian motion)
-        for (auto& p : disk) {
-            p.angle += p.speed * dt;
-            if (p.angle > PI * 2) p.angle -= PI * 2;
+        // The GPU path derives angles from `time` in particles.vs instead, and
+        // the simulated path dispatches its steps below
+        BeginProfilePass(profiler, PASS_PARTICLE_UPDATE);
+        if (particlePath == PARTICLES_CPU && !diskVolume) {
+            // Orbits are uniform, so this frame's steps are a single advance, drawn
+            // (1 - alpha) of a step behind the latest state like the camera
+            float advance = (float)(simSteps * SIM_DT);
+            float lead = -(1.0f - simAlpha) * h;
+            // Frame N draws what the workers built during frame N-1 and queues frame N+1's;
+            // the first CPU frame has nothing in flight, so it builds its own without advancing
+            // Only the prefix being drawn gets vertices; the rest just advance their
+            // angles, so a rising quality level brings them back in their orbits
+            auto queueUpdate = [&](float step) {
+                ParticleVertex* out = cpuDiskVerts[cpuDiskFront ^ 1].data();
+                int count = (int)(cpuDisk.count * level.particleFraction);
+                cpuDiskCounts[cpuDiskFront ^ 1] = count;
+                ParallelFor(jobs, cpuDiskJobs, cpuDisk.count, CPU_PARTICLE_GRAIN,
+                            [&cpuDisk, out, step, lead, count](int begin, int end) {
+                    int drawn = std::clamp(count, begin, end);
+                    if (begin < drawn) UpdateParticleRange(cpuDisk, begin, drawn, step, lead, out);
+                    if (drawn < end) AdvanceParticleAngles(cpuDisk, drawn, end, step);
+                });
+            };
+            if (!cpuDiskInFlight) queueUpdate(0.0f);
+            WaitJobGroup(jobs, cpuDiskJobs);
+            cpuDiskFront ^= 1;
+            queueUpdate(advance);
+            cpuDiskInFlight = true;
+        } else if (cpuDiskInFlight) {
+            WaitJobGroup(jobs, cpuDiskJobs);
+            cpuDiskInFlight = false;
+        }
+        // One dispatch runs all of this frame's steps, numbered by the sim clock
+        // so the result doesn't depend on the frame rate; as on the CPU path,
+        // only the drawn prefix is fully simulated and the rest keep orbiting
+        if (particlePath == PARTICLES_SIM && !diskVolume) {
+            int count = (int)(diskSim.count * level.particleFraction) / holeCount * holeCount;
+            StepDiskSim(diskSim, count, simSteps, h, (unsigned int)(simClock.steps - simSteps), diskInner, DISK_OUTER,
+                        diskSimSeed);
         }
+        EndProfilePass(profiler);
 
-        // Project black hole center to screen-space for shader
+        // Project black hole centers to screen-space for shader
         // Shader operates in normalized UV coordinates [0,1]
-        Vector3 bhWorld = {0, 0, 0};
-        Vector2 bhScreen = GetWorldToScreen(bhWorld, cam);
-        float bhScreenX = bhScreen.x / SCREEN_WIDTH;
-        float bhScreenY = 1.0f - (bhScreen.y / SCREEN_HEIGHT); // Flip Y for OpenGL
+        // Geodesic model works in real units: Rs as seen on screen, and the uv shift of
+        // a ray deflected by α for a source half way between the hole and infinity
+        float lensScale = LENS_SOURCE_RATIO / (cam.fovy * DEG2RAD);
+        ViewSet views = MakeViewSet(viewOpts, cam, renderW, renderH, sceneScale);
+        LensHoleBlock holeBlock = {};
+        holeBlock.holeCount = holeCount;
+        holeBlock.viewCount = views.count;
+        // Bounded mode: union of the squares around every hole the lens reaches
+        float boundX0 = 1e9f, boundY0 = 1e9f, boundX1 = -1e9f, boundY1 = -1e9f;
+        float columnW = (float)renderW / views.count;
+        for (int slot = 0; slot < views.count * holeCount; slot++) {
+            int v = slot / holeCount, i = slot % holeCount;
+            const Camera3D& viewCam = views.cams[v];
+            LensHole& hole = holeBlock.holes[slot];
+            // Behind a fanned-out view's camera the projection would mirror it
+            // back on screen: cull it from every pixel instead
+            if (Vector3DotProduct(Vector3Subtract(holePos[i], viewCam.position),
+                                  Vector3Subtract(viewCam.target, viewCam.position)) <= 0.0f) {
+                hole.x = hole.y = -1e3f;
+                hole.reach = 1e-6f;
+                continue;
+            }
+            // Projected against the view's column of the render target, whose aspect may differ from the window
+            Vector2 bhScreen = GetWorldToScreenEx(holePos[i], viewCam, (int)columnW, renderH);
+            // Shifted by the jitter along with the scene, so the lens stays centred on it
+            hole.x = (bhScreen.x + v * columnW) / renderW + jitter.x / renderW;
+            hole.y = 1.0f - (bhScreen.y / renderH) + jitter.y / renderH; // Flip Y for OpenGL
+
+            // Calculate apparent angular size of event horizon
+            // Offset along the camera's right vector so the edge never lines up with the view axis
+            Vector3 camRight =
+                Vector3Normalize(Vector3CrossProduct(Vector3Subtract(viewCam.target, viewCam.position), viewCam.up));
+            Vector3 bhEdge = Vector3Add(holePos[i], Vector3Scale(camRight, BH_RADIUS));
+            Vector2 bhEdgeScreen = GetWorldToScreenEx(bhEdge, viewCam, (int)columnW, renderH);
+            float bhEdgePixels = fabsf(bhEdgeScreen.x - bhScreen.x);
+            hole.rsScreen = bhEdgePixels / renderH;
+            hole.radius = bhEdgePixels / columnW * 1.5f; // Inflate for visual impact
 
-        // Calculate apparent angular size of event horizon
-        Vector3 bhEdge = {BH_RADIUS, 0, 0};
-        Vector2 bhEdgeScreen = GetWorldToScreen(bhEdge, cam);
-        float bhScreenRadius = fabsf(bhEdgeScreen.x - bhScreen.x) / SCREEN_WIDTH;
+            // Inclination from the spin axis; views from below use the mirrored upper half
+            Vector3 toCam = Vector3Subtract(viewCam.position, holePos[i]);
+            float inclination = acosf(fminf(fabsf(toCam.y) / Vector3Length(toCam), 1.0f));
+            hole.kerrSlice = GetKerrSliceCoord(inclination);
+            hole.kerrFlip = toCam.y < 0.0f ? -1.0f : 1.0f;
+
+            // With several holes the reach also culls each one's lens from the
+            // pixels it can't visibly move; a lone hole is only bounded in [G]
+            if (!boundedLens && holeCount == 1) continue;
+            hole.reach = LensInfluenceRadius(lensModel, hole.radius, hole.rsScreen, lensScale, renderH);
+            float half = hole.reach * renderH;
+            float cx = hole.x * renderW, cy = (1.0f - hole.y) * renderH;
+            boundX0 = fminf(boundX0, cx - half);
+            boundY0 = fminf(boundY0, cy - half);
+            boundX1 = fmaxf(boundX1, cx + half);
+            boundY1 = fmaxf(boundY1, cy + half);
+        }
 
         // === PASS 1: Render 3D scene to offscreen texture ===
-        BeginTextureMode(sceneRT);
+        BeginTextureMode(GetSceneDrawTarget(targets));
         ClearBackground(BG_COLOR);
         BeginMode3D(cam);
 
-        // Background starfield
-        for (const auto& s : stars) {
-            unsigned char c = (unsigned char)(255 * s.brightness);
-            DrawPoint3D({s.x, s.y, s.z}, {c, c, c, 255});
+        // Sub-pixel jitter as an NDC offset (x_ndc -= m8, y_ndc -= m9)
+        Matrix camView = rlGetMatrixModelview(), camProj = rlGetMatrixProjection();
+        Matrix taaViewProj = MatrixMultiply(camView, camProj);
+        if (taa) {
+            camProj.m8 -= 2.0f * jitter.x / renderW;
+            camProj.m9 -= 2.0f * jitter.y / renderH;
+            rlSetMatrixProjection(camProj);
         }
+        // A single view draws with exactly the matrices BeginMode3D set up
+        if (views.count == 1) {
+            views.view[0] = camView;
+            views.proj[0] = camProj;
+        } else {
+            gl::Enable(gl::CLIP_DISTANCE0);
+            gl::Enable(gl::CLIP_DISTANCE1);
+        }
+        // Each hole's rings and disk are drawn in its own frame
+        Matrix holeModel[MAX_HOLES];
+        for (int i = 0; i < holeCount; i++) holeModel[i] = MatrixTranslate(holePos[i].x, holePos[i].y, holePos[i].z);
 
-        // Accretion disk - thin disk approximation in equatorial plane
-        for (int ring = 0; ring < 30; ring++) {
-            float r = DISK_INNER + (float)ring / 30.0f * (DISK_OUTER - DISK_INNER);
-            float temp = (float)ring / 30.0f;
-            for (int i = 0; i < 100; i++) {
-                float a1 = (float)i / 100.0f * PI * 2.0f;
-                float a2 = (float)(i + 1) / 100.0f * PI * 2.0f;
-
-                // Relativistic Doppler: D = √[(1+β·cosθ)/(1-β·cosθ)]
-                // β = v/c, θ = angle between velocity and line of sight
-                float beta = 0.4f / sqrtf(r / DISK_INNER);
-                float cosAngle = cosf(a1);
-
-                float doppler = sqrtf((1.0f + beta * cosAngle) / (1.0f - beta * cosAngle + 0.01f));
-                doppler = fmaxf(0.4f, fminf(1.8f, doppler));
-
-                Color col = GetDiskColor(temp, doppler);
-                col.a = (unsigned char)(220 - temp * 100);
-                DrawLine3D({cosf(a1) * r, 0, sinf(a1) * r},
-                          {cosf(a2) * r, 0, sinf(a2) * r}, col);
+        // Background starfield
+        BeginProfilePass(profiler, PASS_STARS);
+        if (bakedStars) {
+            DrawSkybox(starCube, skyShader, skyInvVpLoc, skyViewsLoc, views, emptyVao);
+        } else {
+            // A wide group puts the camera among the points: keep them at infinity, like the cubemap
+            Matrix starMvp[MAX_VIEWS];
+            for (int v = 0; v < views.count; v++) {
+                Matrix starView = views.view[v];
+                if (holeCount > 1) starView.m12 = starView.m13 = starView.m14 = 0.0f;
+                starMvp[v] = MatrixMultiply(starView, views.proj[v]);
             }
+            SetShaderValueMatrices(starDrawShader, starDrawMvpLoc, starMvp, views.count);
+            SetShaderValue(starDrawShader, starDrawViewsLoc, &views.count, SHADER_UNIFORM_INT);
+            rlEnableShader(starDrawShader.id);
+            DrawStarField(stars, views.count);
+            rlDisableShader();
         }
+        EndProfilePass(profiler);
 
-        // Einstein ring - gravitationally lensed image of the back side of the disk
-        // Light from behind the BH bends over/under, creating bright arcs
-        for (int side = 0; side < 2; side++) {
-            float yDir = (side == 0) ? 1.0f : -1.0f;
+        // Static disk + Einstein ring geometry
+        BeginProfilePass(profiler, PASS_DISK_LINES);
+        BindDiskColorLUT(diskLUT, targets.hdr);
+        SetShaderValue(lineShader, lineTimeLoc, &epochTime, SHADER_UNIFORM_FLOAT);
+        for (int i = 0; i < holeCount; i++) {
+            SetShaderViews(lineShader, lineMvpLoc, lineViewsLoc, views, holeModel[i]);
+            rlEnableShader(lineShader.id);
+            if (!diskVolume) DrawLineGroup(lines, lines.disk, views.count);
+            DrawLineGroup(lines, lines.einstein, views.count);
+            rlDisableShader();
+        }
+        EndProfilePass(profiler);
 
-            for (int layer = 0; layer < 20; layer++) {
-                float layerT = (float)layer / 20.0f;
-                float ringR = BH_RADIUS * (2.2f + layerT * 1.8f);
-                float brightness = 1.0f - layerT * 0.6f;
+        // Animated disk particles for visual depth; the volume replaces them
+        BeginProfilePass(profiler, PASS_PARTICLES);
+        if (!diskVolume && particlePath == PARTICLES_GPU) {
+            // Holes split the drawn particles between them, a separate range each,
+            // so the total cost stays that of one disk and no two disks match
+            SetShaderValue(particleShader, partTimeLoc, &epochTime, SHADER_UNIFORM_FLOAT);
+            SetShaderValue(particleShader, partEpochLoc, &epoch, SHADER_UNIFORM_INT);
+            int count = (int)(gpuDisk.count * level.particleFraction) / holeCount;
+            float partAlpha = fminf(1.0f, DISK_PARTICLE_FLUX / fmaxf(count, 1.0f));
+            SetShaderValue(particleShader, partAlphaLoc, &partAlpha, SHADER_UNIFORM_FLOAT);
+            gl::Enable(gl::PROGRAM_POINT_SIZE);
+            for (int i = 0; i < holeCount; i++) {
+                SetShaderViews(particleShader, partMvpLoc, partViewsLoc, views, holeModel[i]);
+                rlEnableShader(particleShader.id);
+                DrawParticleBuffer(gpuDisk, i * count, count, views.count);
+                rlDisableShader();
+            }
+            gl::Disable(gl::PROGRAM_POINT_SIZE);
+        } else if (!diskVolume && particlePath == PARTICLES_SIM) {
+            // Same split as the GPU path; drawn (1 - alpha) of a step behind the latest state
+            float lead = -(1.0f - simAlpha) * h;
+            SetShaderValue(simParticleShader, simPartLeadLoc, &lead, SHADER_UNIFORM_FLOAT);
+            int count = (int)(diskSim.count * level.particleFraction) / holeCount;
+            float partAlpha = fminf(1.0f, DISK_PARTICLE_FLUX / fmaxf(count, 1.0f));
+            SetShaderValue(simParticleShader, simPartAlphaLoc, &partAlpha, SHADER_UNIFORM_FLOAT);
+            gl::Enable(gl::PROGRAM_POINT_SIZE);
+            for (int i = 0; i < holeCount; i++) {
+                SetShaderViews(simParticleShader, simPartMvpLoc, simPartViewsLoc, views, holeModel[i]);
+                rlEnableShader(simParticleShader.id);
+                DrawDiskSim(diskSim, i * count, count, views.count);
+                rlDisableShader();
+            }
+            gl::Disable(gl::PROGRAM_POINT_SIZE);
+        } else if (!diskVolume) {
+            int total = cpuDiskCounts[cpuDiskFront];
+            UploadParticleStream(cpuDiskStream, cpuDiskVerts[cpuDiskFront], total);
+            int count = total / holeCount;
+            float partAlpha = fminf(1.0f, DISK_PARTICLE_FLUX / fmaxf(count, 1.0f));
+            SetShaderValue(cpuParticleShader, cpuPartAlphaLoc, &partAlpha, SHADER_UNIFORM_FLOAT);
+            for (int i = 0; i < holeCount; i++) {
+                SetShaderViews(cpuParticleShader, cpuPartMvpLoc, cpuPartViewsLoc, views, holeModel[i]);
+                rlEnableShader(cpuParticleShader.id);
+                DrawParticleBuffer(cpuDiskStream, i * count, count, views.count);
+                rlDisableShader();
+            }
+        }
 
-                for (int i = 0; i < 120; i++) {
-                    float a1 = (float)i / 120.0f * PI * 2.0f;
-                    float a2 = (float)(i + 1) / 120.0f * PI * 2.0f;
+        EndProfilePass(profiler);
 
-                    // Vertical displacement peaks at sides (θ = π/2, 3π/2)
-                    // where light path grazes closest to photon sphere
-                    float curveHeight = 1.5f - layerT * 0.3f;
-                    float bend1 = fabsf(sinf(a1)) * curveHeight * yDir;
-                    float bend2 = fabsf(sinf(a2)) * curveHeight * yDir;
+        // Photon sphere and inner glow drawn over the particles
+        BeginProfilePass(profiler, PASS_PHOTON_LINES);
+        for (int i = 0; i < holeCount; i++) {
+            SetShaderViews(lineShader, lineMvpLoc, lineViewsLoc, views, holeModel[i]);
+            rlEnableShader(lineShader.id);
+            DrawLineGroup(lines, lines.photon, views.count);
+            DrawLineGroup(lines, lines.glow, views.count);
+            rlDisableShader();
+        }
+        EndProfilePass(profiler);
 
-                    // Z compression simulates viewing angle of lensed disk
-                    float zComp = 0.15f + layerT * 0.05f;
+        if (views.count > 1) {
+            gl::Disable(gl::CLIP_DISTANCE0);
+            gl::Disable(gl::CLIP_DISTANCE1);
+        }
+        EndMode3D();
+        EndTextureMode();
+        if (targets.msaa.rt.id) ResolveMsaaTarget(targets.msaa, targets.scene);
 
-                    Vector3 p1 = {cosf(a1) * ringR, bend1, sinf(a1) * ringR * zComp};
-                    Vector3 p2 = {cosf(a2) * ringR, bend2, sinf(a2) * ringR * zComp};
+        // Ray-marched disk, kept out of the scene so the screen-space lens doesn't bend it again
+        BeginProfilePass(profiler, PASS_DISK_VOLUME);
+        if (diskVolume) {
+            BindDiskColorLUT(diskLUT, targets.hdr);
+            DrawDiskVolume(targets.volume, volumeShaders, camView, camProj, cam.position, epoch, epochTime, emptyVao);
+        }
+        EndProfilePass(profiler);
 
-                    float beta = 0.25f;
-                    float doppler = sqrtf((1.0f + beta * cosf(a1)) / (1.0f - beta * cosf(a1) + 0.01f));
-                    doppler = fmaxf(0.6f, fminf(1.5f, doppler));
+        // Bloom chain at half resolution and below, unless the stage is off
+        BeginProfilePass(profiler, PASS_BLOOM);
+        if (stages & LENS_BLOOM) {
+            ApplyBloom(targets.bloom, bloomShaders, targets.scene.texture, level.bloomLevels);
+            // Each upsample step adds one level's worth of glow
+            float bloomIntensity = 1.0f / level.bloomLevels;
+            SetShaderValue(lens.shader, lens.bloomIntensityLoc, &bloomIntensity, SHADER_UNIFORM_FLOAT);
+            SetShaderValue(lite.shader, lite.bloomIntensityLoc, &bloomIntensity, SHADER_UNIFORM_FLOAT);
+        }
+        EndProfilePass(profiler);
 
-                    Color col = GetDiskColor(layerT * 0.4f, doppler);
-                    col.a = (unsigned char)(brightness * 255);
+        // === PASS 2: Apply gravitational lensing shader ===
+        BeginProfilePass(profiler, PASS_LENSING);
+        float resolution[2] = {(float)targets.width, (float)targets.height};
+        UploadLensHoles(lensShaders, holeBlock);
 
-                    DrawLine3D(p1, p2, col);
-                }
-            }
-        }
+        SetShaderValue(lens.shader, lens.resLoc, resolution, SHADER_UNIFORM_VEC2);
+        SetShaderValue(lens.shader, lens.timeLoc, &epochTime, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(lens.shader, lens.lensModelLoc, &lensModel, SHADER_UNIFORM_INT);
+        SetShaderValue(lens.shader, lens.lensScaleLoc, &lensScale, SHADER_UNIFORM_FLOAT);
 
-        // Animated disk particles for visual depth
-        for (const auto& p : disk) {
-            float x = cosf(p.angle) * p.radius;
-            float z = sinf(p.angle) * p.radius;
-            float t = (p.radius - DISK_INNER) / (DISK_OUTER - DISK_INNER);
-            
-            float beta = 0.4f / sqrtf(p.radius / DISK_INNER);
-            float cosAngle = cosf(p.angle);
-            float doppler = sqrtf((1.0f + beta * cosAngle) / (1.0f - beta * cosAngle + 0.01f));
-            doppler = fmaxf(0.4f, fminf(1.8f, doppler));
-            
-            DrawPoint3D({x, p.yOffset, z}, GetDiskColor(t, doppler));
+        // Bounded mode: full shader only on the region around the holes
+        Rectangle lensRect = {0, 0, (float)targets.width, (float)targets.height};
+        Rectangle liteRects[4];
+        int liteCount = 0;
+        if (boundedLens) {
+            liteCount = SplitLensRegion(targets.width, targets.height,
+                                        {boundX0, boundY0, boundX1 - boundX0, boundY1 - boundY0}, lensRect, liteRects);
+            SetShaderValue(lite.shader, lite.resLoc, resolution, SHADER_UNIFORM_VEC2);
         }
+        int volumeMode = diskVolume ? 1 : 0;
+        SetShaderValue(lens.shader, lens.volumeModeLoc, &volumeMode, SHADER_UNIFORM_INT);
+        SetShaderValue(lite.shader, lite.volumeModeLoc, &volumeMode, SHADER_UNIFORM_INT);
 
-        // Photon sphere at r = 1.5 Rs - unstable circular photon orbits
-        // Any photon here will either fall in or escape to infinity
-        for (int layer = 0; layer < 8; layer++) {
-            float r = BH_RADIUS * 1.5f + layer * 0.03f;
-            float alpha = 1.0f - layer * 0.1f;
-            for (int i = 0; i < 120; i++) {
-                float a1 = (float)i / 120.0f * PI * 2.0f;
-                float a2 = (float)(i + 1) / 120.0f * PI * 2.0f;
-                float flicker = 0.9f + 0.1f * sinf(a1 * 3.0f + time * 2.0f);
-                unsigned char c = (unsigned char)(255 * alpha * flicker);
-                DrawLine3D({cosf(a1) * r, 0, sinf(a1) * r},
-                          {cosf(a2) * r, 0, sinf(a2) * r},
-                          {c, (unsigned char)(c*0.9f), (unsigned char)(c*0.7f), 255});
+        // Lensing runs at the internal resolution, into the lensed target or
+        // straight into the backbuffer when that is the same size
+        auto drawLensed = [&]() {
+            // RenderTexture Y-flip required due to OpenGL texture coordinate convention
+            if (lensRect.width > 0) {
+                SetShaderValueTexture(lens.shader, lens.bloomLoc, targets.bloom.down[0].texture);
+                SetShaderValueTexture(lens.shader, lens.deflectionLoc, deflection.texture);
+                if (lensModel == 2) SetShaderValueTexture(lens.shader, lens.kerrMapLoc, kerr.texture);
+                if (diskVolume) SetShaderValueTexture(lens.shader, lens.volumeLoc, GetDiskVolumeTexture(targets.volume));
+                BeginShaderMode(lens.shader);
+                DrawTextureRegion(targets.scene.texture, lensRect);
+                EndShaderMode();
             }
-        }
-
-        // Inner glow - represents extreme gravitational redshift near horizon
-        // Light escaping from here loses most of its energy climbing out
-        for (int layer = 0; layer < 4; layer++) {
-            float r = BH_RADIUS * (1.1f + layer * 0.08f);
-            float alpha = 0.4f - layer * 0.08f;
-            for (int i = 0; i < 60; i++) {
-                float a1 = (float)i / 60.0f * PI * 2.0f;
-                float a2 = (float)(i + 1) / 60.0f * PI * 2.0f;
-                unsigned char c = (unsigned char)(255 * alpha);
-                DrawLine3D({cosf(a1) * r, 0, sinf(a1) * r},
-                          {cosf(a2) * r, 0, sinf(a2) * r},
-                          {c, (unsigned char)(c*0.8f), (unsigned char)(c*0.5f), (unsigned char)(alpha * 255)});
+            if (liteCount > 0) {
+                SetShaderValueTexture(lite.shader, lite.bloomLoc, targets.bloom.down[0].texture);
+                if (diskVolume) SetShaderValueTexture(lite.shader, lite.volumeLoc, GetDiskVolumeTexture(targets.volume));
+                BeginShaderMode(lite.shader);
+                for (int i = 0; i < liteCount; i++) DrawTextureRegion(targets.scene.texture, liteRects[i]);
+                EndShaderMode();
             }
+        };
+
+        if (resample) {
+            BeginTextureMode(targets.lensed);
+            ClearBackground(BLACK);
+            drawLensed();
+            EndTextureMode();
         }
 
-        EndMode3D();
-        EndTextureMode();
+        if (taa) {
+            float texel[2] = {1.0f / targets.width, 1.0f / targets.height};
+            float valid = taaHistory.valid ? 1.0f : 0.0f;
+            Matrix invViewProj = MatrixInvert(taaViewProj);
+            SetShaderValue(taaShader, taaTexelLoc, texel, SHADER_UNIFORM_VEC2);
+            SetShaderValue(taaShader, taaJitterLoc, &jitter, SHADER_UNIFORM_VEC2);
+            SetShaderValueMatrix(taaShader, taaInvViewProjLoc, invViewProj);
+            SetShaderValueMatrix(taaShader, taaPrevViewProjLoc, taaHistory.prevViewProj);
+            SetShaderValue(taaShader, taaCameraPosLoc, &cam.position, SHADER_UNIFORM_VEC3);
+            SetShaderValue(taaShader, taaValidLoc, &valid, SHADER_UNIFORM_FLOAT);
+            SetShaderValueTexture(taaShader, taaHistoryLoc, taaHistory.buffer[taaHistory.current].texture);
+
+            taaHistory.current ^= 1;
+            BeginTextureMode(taaHistory.buffer[taaHistory.current]);
+            BeginShaderMode(taaShader);
+            DrawTexturePro(targets.lensed.texture, {0, 0, (float)targets.width, -(float)targets.height},
+                           {0, 0, (float)taaHistory.width, (float)taaHistory.height}, {0, 0}, 0.0f, WHITE);
+            EndShaderMode();
+            EndTextureMode();
+            taaHistory.valid = true;
+            taaHistory.prevViewProj = taaViewProj;
+        }
+        if (exportOpts.enabled) CaptureExportFrame(exporter, taa ? taaHistory.buffer[taaHistory.current] : targets.lensed);
 
-        // === PASS 2: Apply gravitational lensing shader ===
         BeginDrawing();
         ClearBackground(BLACK);
 
-        float resolution[2] = {(float)SCREEN_WIDTH, (float)SCREEN_HEIGHT};
-        float bhPos[2] = {bhScreenX, bhScreenY};
-        float bhRad = bhScreenRadius * 1.5f; // Inflate for visual impact
-
-        SetShaderValue(lensShader, resLoc, resolution, SHADER_UNIFORM_VEC2);
-        SetShaderValue(lensShader, bhPosLoc, bhPos, SHADER_UNIFORM_VEC2);
-        SetShaderValue(lensShader, bhRadLoc, &bhRad, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(lensShader, timeLoc, &time, SHADER_UNIFORM_FLOAT);
-
-        BeginShaderMode(lensShader);
-        // RenderTexture Y-flip required due to OpenGL texture coordinate convention
-        DrawTextureRec(sceneRT.texture,
-                       {0, 0, (float)SCREEN_WIDTH, -(float)SCREEN_HEIGHT},
-                       {0, 0}, WHITE);
-        EndShaderMode();
+        if (taa) {
+            // Already at the output resolution; export previews are scaled to the window
+            const RenderTexture2D& resolved = taaHistory.buffer[taaHistory.current];
+            DrawTexturePro(resolved.texture, {0, 0, (float)taaHistory.width, -(float)taaHistory.height},
+                           {0, 0, (float)screenW, (float)screenH}, {0, 0}, 0.0f, WHITE);
+        } else if (resample) {
+            // Export frames are only previewed here, so skip sharpening the downscale
+            float texel[2] = {1.0f / targets.width, 1.0f / targets.height};
+            float sharpness = sharpen && !exportOpts.enabled ? 0.5f : 0.0f;
+            SetShaderValue(upscaleShader, upTexelLoc, texel, SHADER_UNIFORM_VEC2);
+            SetShaderValue(upscaleShader, upSharpLoc, &sharpness, SHADER_UNIFORM_FLOAT);
+            BeginShaderMode(upscaleShader);
+            DrawTexturePro(targets.lensed.texture,
+                           {0, 0, (float)targets.width, -(float)targets.height},
+                           {0, 0, (float)screenW, (float)screenH}, {0, 0}, 0.0f, WHITE);
+            EndShaderMode();
+        } else {
+            drawLensed();
+        }
+        EndProfilePass(profiler);
 
+        BeginProfilePass(profiler, PASS_HUD);
         DrawText("GARGANTUA", 10, 10, 30, WHITE);
         DrawText("Gravitational Lensing Shader", 10, 45, 16, GRAY);
-        DrawText("[WASD] Orbit  [QE] Zoom  [SPACE] Auto", 10, SCREEN_HEIGHT - 25, 14, GRAY);
-        DrawFPS(SCREEN_WIDTH - 80, 10);
+        DrawText(TextFormat("[WASD] Orbit  [QE] Zoom  [SPACE] Auto  [P] Particles: %s  [B] Stars: %s  [L] Lens: %s",
+                            particlePath == PARTICLES_GPU ? "GPU" : particlePath == PARTICLES_SIM ? "Sim" : GetParticleKernelName(), bakedStars ? "Cubemap" : "Points",
+                            lensModel == 2 ? TextFormat("Kerr a=%.2f%s [[ ]]", spin, kerr.building ? "..." : "")
+                            : lensModel ? "Geodesic" : "Artistic"), 10, screenH - 25, 14, GRAY);
+        DrawText(TextFormat("[R] Scale: %s%d%%  [F] Sharpen: %s  [H] Scene: %s  [T] AA: %s",
+                            quality.enabled ? TextFormat("Auto L%d ", quality.level) : "", (int)(renderScale * 100.0f + 0.5f),
+                            sharpen ? "On" : "Off",
+                            !targets.hdr ? "RGBA8" : targets.msaa.rt.id ? "RGBA16F MSAA" : "RGBA16F",
+                            taa ? "TAA" : "FXAA"),
+                 10, screenH - 45, 14, GRAY);
+        DrawText(TextFormat("%s  [V] Disk: %s  Holes: %d  Views: %d%s",
+                            boundedLens ? TextFormat("[G] Bounded lensing: %d%% of frame",
+                                                     (int)(100.0f * lensRect.width * lensRect.height /
+                                                           (targets.width * targets.height)))
+                                        : "[G] Bounded lensing: Off",
+                            diskVolume == 1 ? "Volume 1/2" : diskVolume == 2 ? "Volume" : "Rings", holeCount,
+                            views.count, viewOpts.stereo ? " (stereo)" : ""),
+                 10, screenH - 65, 14, GRAY);
+        DrawText(TextFormat("Segments: disk %d  einstein %d  photon %d  glow %d  Lens stages: %s",
+                            LineLODSegments(lines.disk.baseSegments, lines.disk.level),
+                            LineLODSegments(lines.einstein.baseSegments, lines.einstein.level),
+                            LineLODSegments(lines.photon.baseSegments, lines.photon.level),
+                            LineLODSegments(lines.glow.baseSegments, lines.glow.level),
+                            FormatLensStages(stages).c_str()),
+                 10, screenH - 85, 14, GRAY);
+        DrawText("[F1] Profiler  [F11] Fullscreen", screenW - 230, 32, 14, GRAY);
+        DrawFPS(screenW - 80, 10);
+        if (showProfiler) DrawProfilerOverlay(profiler, screenW - 480, 52);
+        if (exportOpts.enabled) {
+            DrawText(TextFormat("EXPORTING %d / %d  (%dx%d)", exporter.captured, exportOpts.frames,
+                                exportOpts.width, exportOpts.height), 10, 70, 20, RED);
+        }
+        EndProfilePass(profiler);
 
         EndDrawing();
+        EndProfileFrame(profiler);
+        if (bench.opts.enabled) CollectBenchmarkFrames(bench, profiler, false);
     }
 
-    UnloadShader(lensShader);
-    UnloadRenderTexture(sceneRT);
+    bool runOk = true;
+    if (bench.opts.enabled) {
+        FinishProfiler(profiler);
+        CollectBenchmarkFrames(bench, profiler, true);
+        runOk = WriteBenchmarkReport(bench, output.width, output.height);
+    }
+    if (exportOpts.enabled) {
+        runOk = FinishExport(exporter) && exporter.written == exportOpts.frames;
+    }
+
+    UnloadProfiler(profiler);
+    WaitJobGroup(jobs, cpuDiskJobs);
+    UnloadKerrLensMap(kerr, jobs);
+    StopJobSystem(jobs);
+
+    UnloadParticleBuffer(gpuDisk);
+    UnloadParticleBuffer(cpuDiskStream);
+    UnloadDiskSim(diskSim);
+    UnloadStarField(stars);
+    UnloadTexture(starCube);
+    gl::DeleteVertexArrays(1, &emptyVao);
+    UnloadShader(starShader);
+    UnloadShader(catalogShader);
+    CloseStarCatalog(catalog);
+    UnloadShader(skyShader);
+    UnloadLineMesh(lines);
+    UnloadDiskColorLUT(diskLUT);
+    UnloadShader(particleShader);
+    UnloadShader(cpuParticleShader);
+    UnloadShader(simParticleShader);
+    UnloadShader(lineShader);
+    UnloadLensShaders(lensShaders);
+    UnloadDeflectionLUT(deflection);
+    UnloadFrameTargets(targets);
+    UnloadBloomShaders(bloomShaders);
+    UnloadDiskVolumeShaders(volumeShaders);
+    UnloadShader(upscaleShader);
+    UnloadShader(taaShader);
+    UnloadTaaHistory(taaHistory);
     CloseWindow();
-    return 0;
+    return runOk ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+// Keep GDI/USER out: their Rectangle, CloseWindow, DrawText, ... clash with raylib's
+#define WIN32_LEAN_AND_MEAN
+#define NOGDI
+#define NOUSER
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MapFile(MappedFile& f, const std::string& path) {
+    f = {};
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    HANDLE mapping = GetFileSizeEx(file, &size) ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    f.file = file;
+    f.mapping = mapping;
+    f.view = view;
+    f.size = (size_t)size.QuadPart;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping keeps the file referenced on its own
+    close(fd);
+    if (view == MAP_FAILED) return false;
+    f.view = view;
+    f.size = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+void UnmapFile(MappedFile& f) {
+#if defined(_WIN32)
+    if (f.view) UnmapViewOfFile(f.view);
+    if (f.mapping) CloseHandle(f.mapping);
+    if (f.file) CloseHandle(f.file);
+#else
+    if (f.view) munmap((void*)f.view, f.size);
+#endif
+    f = {};
+}
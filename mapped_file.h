@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. Pages are only read in when
+// touched, so callers can map large files and use a prefix of them.
+struct MappedFile {
+    const void* view = nullptr;      // Mapping base and length
+    size_t size = 0;
+#if defined(_WIN32)
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+};
+
+// False (without logging) if the file is missing, empty or can't be mapped
+bool MapFile(MappedFile& f, const std::string& path);
+void UnmapFile(MappedFile& f);
@@ -0,0 +1,161 @@
+#include "particle_kernel_impl.h"
+
+#include <cmath>
+
+#if !defined(PARTICLE_KERNEL_SCALAR) && (defined(__aarch64__) || defined(_M_ARM64))
+#define PARTICLE_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(PARTICLE_KERNEL_AVX2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+// Reference implementation of the ops interface; also runs the tail of every
+// range that doesn't fill a whole vector
+struct ScalarOps {
+    using R = float;
+    using M = bool;
+    static const int WIDTH = 1;
+
+    static R Load(const float* p) { return *p; }
+    static void Store(float* p, R v) { *p = v; }
+    static R Set(float x) { return x; }
+    static R Add(R a, R b) { return a + b; }
+    static R Sub(R a, R b) { return a - b; }
+    static R Mul(R a, R b) { return a * b; }
+    static R Div(R a, R b) { return a / b; }
+    static R Fma(R a, R b, R c) { return a * b + c; }
+    static R Sqrt(R a) { return sqrtf(a); }
+    static R Min(R a, R b) { return fminf(a, b); }
+    static R Max(R a, R b) { return fmaxf(a, b); }
+    static R Round(R a) { return nearbyintf(a); }
+    static M Less(R a, R b) { return a < b; }
+    static M And(M a, M b) { return a && b; }
+    static M Or(M a, M b) { return a || b; }
+    static R Select(M m, R a, R b) { return m ? a : b; }
+    static void StoreVertices(ParticleVertex* out, R x, R y, R z, R d) { *out = {x, y, z, d}; }
+};
+
+#if defined(PARTICLE_KERNEL_NEON)
+// AArch64 only: vdivq/vsqrtq/vrndnq don't exist on 32-bit NEON
+struct NeonOps {
+    using R = float32x4_t;
+    using M = uint32x4_t;
+    static const int WIDTH = 4;
+
+    static R Load(const float* p) { return vld1q_f32(p); }
+    static void Store(float* p, R v) { vst1q_f32(p, v); }
+    static R Set(float x) { return vdupq_n_f32(x); }
+    static R Add(R a, R b) { return vaddq_f32(a, b); }
+    static R Sub(R a, R b) { return vsubq_f32(a, b); }
+    static R Mul(R a, R b) { return vmulq_f32(a, b); }
+    static R Div(R a, R b) { return vdivq_f32(a, b); }
+    static R Fma(R a, R b, R c) { return vfmaq_f32(c, a, b); }
+    static R Sqrt(R a) { return vsqrtq_f32(a); }
+    static R Min(R a, R b) { return vminq_f32(a, b); }
+    static R Max(R a, R b) { return vmaxq_f32(a, b); }
+    static R Round(R a) { return vrndnq_f32(a); }
+    static M Less(R a, R b) { return vcltq_f32(a, b); }
+    static M And(M a, M b) { return vandq_u32(a, b); }
+    static M Or(M a, M b) { return vorrq_u32(a, b); }
+    static R Select(M m, R a, R b) { return vbslq_f32(m, a, b); }
+
+    // vst4 interleaves the four registers into {x, y, z, doppler} vertices
+    static void StoreVertices(ParticleVertex* out, R x, R y, R z, R d) {
+        float32x4x4_t v = {{x, y, z, d}};
+        vst4q_f32(&out->x, v);
+    }
+};
+#endif
+
+// Runs the widest kernel over a prefix of [begin, end) and returns where it stopped
+using KernelFn = int (*)(const ParticleSpan&, int, int, float, float, ParticleVertex*);
+
+template <class V>
+int AdvanceParticlesWith(const ParticleSpan& p, int begin, int end, float dt, float lead, ParticleVertex* out) {
+    int simdEnd = begin + (end - begin) / V::WIDTH * V::WIDTH;
+    particle_kernel::AdvanceParticles<V>(p, begin, simdEnd, dt, lead, out);
+    return simdEnd;
+}
+
+#if defined(PARTICLE_KERNEL_AVX2)
+bool CpuHasAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool fma = (info[2] & (1 << 12)) != 0, osxsave = (info[2] & (1 << 27)) != 0;
+    // The OS must save the YMM registers across context switches
+    if (!fma || !osxsave || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+#endif
+
+struct Kernel {
+    KernelFn fn;
+    const char* name;
+};
+
+Kernel SelectKernel() {
+#if defined(PARTICLE_KERNEL_AVX2)
+    if (CpuHasAvx2()) return {AdvanceParticlesAVX2, "CPU AVX2"};
+#endif
+#if defined(PARTICLE_KERNEL_NEON)
+    return {AdvanceParticlesWith<NeonOps>, "CPU NEON"};
+#else
+    return {AdvanceParticlesWith<ScalarOps>, "CPU scalar"};
+#endif
+}
+
+const Kernel& GetKernel() {
+    static const Kernel kernel = SelectKernel();
+    return kernel;
+}
+
+} // namespace
+
+ParticleSoA LoadParticleSoA(const std::vector<Particle>& particles, float diskInner, float dMin, float dMax) {
+    ParticleSoA soa;
+    soa.count = (int)particles.size();
+    soa.dopplerMin = dMin;
+    soa.dopplerMax = dMax;
+    for (const auto& p : particles) {
+        soa.angle.push_back(p.angle);
+        soa.radius.push_back(p.radius);
+        soa.speed.push_back(p.speed);
+        soa.yOffset.push_back(p.yOffset);
+        soa.beta.push_back(0.4f / sqrtf(p.radius / diskInner));
+    }
+    return soa;
+}
+
+void UpdateParticleRange(ParticleSoA& soa, int begin, int end, float dt, float lead, ParticleVertex* out) {
+    ParticleSpan span = {soa.angle.data(), soa.radius.data(), soa.speed.data(), soa.yOffset.data(),
+                         soa.beta.data(), soa.dopplerMin, soa.dopplerMax};
+    int done = GetKernel().fn(span, begin, end, dt, lead, out);
+    particle_kernel::AdvanceParticles<ScalarOps>(span, done, end, dt, lead, out);
+}
+
+void UpdateParticles(ParticleSoA& soa, float dt, float lead, ParticleVertex* out) {
+    UpdateParticleRange(soa, 0, soa.count, dt, lead, out);
+}
+
+void AdvanceParticleAngles(ParticleSoA& soa, int begin, int end, float dt) {
+    float* angle = soa.angle.data();
+    const float* speed = soa.speed.data();
+    for (int i = begin; i < end; i++) {
+        // Same single wrap as the kernels; simple enough for the compiler to vectorise
+        float a = angle[i] + speed[i] * dt;
+        angle[i] = a < particle_kernel::TWO_PI ? a : a - particle_kernel::TWO_PI;
+    }
+}
+
+const char* GetParticleKernelName() {
+    return GetKernel().name;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+// CPU disk particle path. Particle state is kept as one array per field and
+// advanced by a vectorized kernel (AVX2 on x86-64 when the CPU has it, NEON on
+// AArch64, scalar otherwise) that integrates the orbit, evaluates sin/cos and
+// the Doppler factor, and writes the vertex stream drawn by particles_cpu.vs.
+
+struct Particle { float angle, radius, speed, yOffset; };
+
+// One vertex per particle, uploaded as a vec4: position and Doppler factor
+// (temperature follows from the radius, so the shader rebuilds it)
+struct ParticleVertex { float x, y, z, doppler; };
+
+struct ParticleSoA {
+    int count = 0;
+    std::vector<float> angle, radius, speed, yOffset;
+    std::vector<float> beta;         // Orbital v/c, fixed per particle
+    float dopplerMin = 0.4f, dopplerMax = 1.8f;
+};
+
+// `diskInner` sets β = 0.4 / √(r / diskInner); D is clamped to [dMin, dMax]
+ParticleSoA LoadParticleSoA(const std::vector<Particle>& particles, float diskInner, float dMin, float dMax);
+
+// Advances particles [begin, end) by dt (angles wrapped to [0, 2π)) and writes
+// their vertices to out[begin, end) as they are `lead` seconds later; lead is
+// not stored, so a negative lead interpolates back towards the previous step.
+// Disjoint ranges may run concurrently.
+void UpdateParticleRange(ParticleSoA& soa, int begin, int end, float dt, float lead, ParticleVertex* out);
+void UpdateParticles(ParticleSoA& soa, float dt, float lead, ParticleVertex* out);
+
+// Advances only the angles of [begin, end), writing no vertices: keeps the
+// particles a quality level isn't drawing on their orbits at a fraction of the cost
+void AdvanceParticleAngles(ParticleSoA& soa, int begin, int end, float dt);
+
+// Particles per job; a multiple of every kernel width so chunks have no scalar tail
+const int CPU_PARTICLE_GRAIN = 8192;
+
+// Name of the kernel picked for this CPU, e.g. "CPU AVX2"
+const char* GetParticleKernelName();
@@ -0,0 +1,51 @@
+// Built with -mavx2 -mfma (/arch:AVX2) and only called once the CPU is known to
+// support both; see particle_kernel.cpp
+#include "particle_kernel_impl.h"
+
+#include <immintrin.h>
+
+namespace {
+
+struct Avx2Ops {
+    using R = __m256;
+    using M = __m256;
+    static const int WIDTH = 8;
+
+    static R Load(const float* p) { return _mm256_loadu_ps(p); }
+    static void Store(float* p, R v) { _mm256_storeu_ps(p, v); }
+    static R Set(float x) { return _mm256_set1_ps(x); }
+    static R Add(R a, R b) { return _mm256_add_ps(a, b); }
+    static R Sub(R a, R b) { return _mm256_sub_ps(a, b); }
+    static R Mul(R a, R b) { return _mm256_mul_ps(a, b); }
+    static R Div(R a, R b) { return _mm256_div_ps(a, b); }
+    static R Fma(R a, R b, R c) { return _mm256_fmadd_ps(a, b, c); }
+    static R Sqrt(R a) { return _mm256_sqrt_ps(a); }
+    static R Min(R a, R b) { return _mm256_min_ps(a, b); }
+    static R Max(R a, R b) { return _mm256_max_ps(a, b); }
+    static R Round(R a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static M Less(R a, R b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static M And(M a, M b) { return _mm256_and_ps(a, b); }
+    static M Or(M a, M b) { return _mm256_or_ps(a, b); }
+    static R Select(M m, R a, R b) { return _mm256_blendv_ps(b, a, m); }
+
+    // 4x8 transpose into eight consecutive {x, y, z, doppler} vertices
+    static void StoreVertices(ParticleVertex* out, R x, R y, R z, R d) {
+        __m256 xy0 = _mm256_unpacklo_ps(x, y), xy1 = _mm256_unpackhi_ps(x, y);
+        __m256 zd0 = _mm256_unpacklo_ps(z, d), zd1 = _mm256_unpackhi_ps(z, d);
+        __m256 v0 = _mm256_shuffle_ps(xy0, zd0, 0x44), v1 = _mm256_shuffle_ps(xy0, zd0, 0xEE);
+        __m256 v2 = _mm256_shuffle_ps(xy1, zd1, 0x44), v3 = _mm256_shuffle_ps(xy1, zd1, 0xEE);
+        float* f = &out->x;
+        _mm256_storeu_ps(f, _mm256_permute2f128_ps(v0, v1, 0x20));
+        _mm256_storeu_ps(f + 8, _mm256_permute2f128_ps(v2, v3, 0x20));
+        _mm256_storeu_ps(f + 16, _mm256_permute2f128_ps(v0, v1, 0x31));
+        _mm256_storeu_ps(f + 24, _mm256_permute2f128_ps(v2, v3, 0x31));
+    }
+};
+
+} // namespace
+
+int AdvanceParticlesAVX2(const ParticleSpan& p, int begin, int end, float dt, float lead, ParticleVertex* out) {
+    int simdEnd = begin + (end - begin) / Avx2Ops::WIDTH * Avx2Ops::WIDTH;
+    particle_kernel::AdvanceParticles<Avx2Ops>(p, begin, simdEnd, dt, lead, out);
+    return simdEnd;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "particle_kernel.h"
+
+// Kernel body shared by every instruction set. An instruction set is a struct
+// of static functions over its register type R and compare mask M; see
+// ScalarOps in particle_kernel.cpp for the full list.
+//
+// Only included by the kernel translation units. particle_kernel_avx2.cpp is
+// built with -mavx2, so everything here is a template over the ops struct and
+// works on raw pointers: an inline function or library template emitted there
+// could otherwise be the copy the linker keeps for the whole program.
+
+struct ParticleSpan {
+    float* angle;
+    const float *radius, *speed, *yOffset, *beta;
+    float dopplerMin, dopplerMax;
+};
+
+namespace particle_kernel {
+
+const float TWO_PI = 6.28318530718f;
+const float TWO_OVER_PI = 0.636619772368f;
+// π/2 split in three for Cody-Waite reduction (Cephes sinf)
+const float PIO2_1 = 1.5703125f;
+const float PIO2_2 = 4.837512969970703125e-4f;
+const float PIO2_3 = 7.54978995489188216e-8f;
+
+// sin and cos of a ∈ [0, 2π]: reduce to r ∈ [-π/4, π/4] around the nearest
+// multiple j of π/2, evaluate both minimax polynomials, then swap and negate by quadrant
+template <class V>
+inline void SinCos(typename V::R a, typename V::R& s, typename V::R& c) {
+    using R = typename V::R;
+    R j = V::Round(V::Mul(a, V::Set(TWO_OVER_PI)));
+    R r = V::Fma(j, V::Set(-PIO2_1), a);
+    r = V::Fma(j, V::Set(-PIO2_2), r);
+    r = V::Fma(j, V::Set(-PIO2_3), r);
+    // Quadrant 4 is quadrant 0 a turn later
+    j = V::Select(V::Less(j, V::Set(3.5f)), j, V::Sub(j, V::Set(4.0f)));
+
+    R z = V::Mul(r, r);
+    R ps = V::Fma(V::Fma(V::Fma(V::Set(-1.9515295891e-4f), z, V::Set(8.3321608736e-3f)), z, V::Set(-1.6666654611e-1f)),
+                  V::Mul(z, r), r);
+    R pc = V::Fma(V::Fma(V::Set(2.443315711809948e-5f), z, V::Set(-1.388731625493765e-3f)), z, V::Set(4.166664568298827e-2f));
+    pc = V::Fma(V::Mul(pc, z), z, V::Fma(z, V::Set(-0.5f), V::Set(1.0f)));
+
+    // j = 1, 3 swap sin and cos; sin < 0 for j = 2, 3; cos < 0 for j = 1, 2
+    auto odd = V::Or(V::And(V::Less(V::Set(0.5f), j), V::Less(j, V::Set(1.5f))), V::Less(V::Set(2.5f), j));
+    auto sinNeg = V::Less(V::Set(1.5f), j);
+    auto cosNeg = V::And(V::Less(V::Set(0.5f), j), V::Less(j, V::Set(2.5f)));
+    s = V::Select(odd, pc, ps);
+    c = V::Select(odd, ps, pc);
+    s = V::Select(sinNeg, V::Sub(V::Set(0.0f), s), s);
+    c = V::Select(cosNeg, V::Sub(V::Set(0.0f), c), c);
+}
+
+// Processes [begin, end), which must be a whole number of V::WIDTH chunks
+template <class V>
+void AdvanceParticles(const ParticleSpan& p, int begin, int end, float dt, float lead, ParticleVertex* out) {
+    using R = typename V::R;
+    const R vdt = V::Set(dt), vlead = V::Set(lead), zero = V::Set(0.0f), twoPi = V::Set(TWO_PI);
+    const R one = V::Set(1.0f), eps = V::Set(0.01f);
+    const R dMin = V::Set(p.dopplerMin), dMax = V::Set(p.dopplerMax);
+
+    for (int i = begin; i < end; i += V::WIDTH) {
+        // Keplerian motion, wrapped once per step like the old scalar loop
+        R angle = V::Fma(V::Load(p.speed + i), vdt, V::Load(p.angle + i));
+        angle = V::Select(V::Less(angle, twoPi), angle, V::Sub(angle, twoPi));
+        V::Store(p.angle + i, angle);
+
+        // Drawn `lead` seconds away from the stored state (render interpolation)
+        R shown = V::Fma(V::Load(p.speed + i), vlead, angle);
+        shown = V::Select(V::Less(shown, zero), V::Add(shown, twoPi), shown);
+        shown = V::Select(V::Less(shown, twoPi), shown, V::Sub(shown, twoPi));
+
+        R s, c;
+        SinCos<V>(shown, s, c);
+        R radius = V::Load(p.radius + i);
+
+        // D = √[(1+β·cosθ)/(1-β·cosθ+0.01)], as DopplerFactor() in disk_color.cpp
+        R bc = V::Mul(V::Load(p.beta + i), c);
+        R doppler = V::Sqrt(V::Div(V::Add(one, bc), V::Add(V::Sub(one, bc), eps)));
+        doppler = V::Min(dMax, V::Max(dMin, doppler));
+
+        V::StoreVertices(out + i, V::Mul(c, radius), V::Load(p.yOffset + i), V::Mul(s, radius), doppler);
+    }
+}
+
+} // namespace particle_kernel
+
+// particle_kernel_avx2.cpp; same contract as AdvanceParticlesWith() in particle_kernel.cpp
+int AdvanceParticlesAVX2(const ParticleSpan& p, int begin, int end, float dt, float lead, ParticleVertex* out);
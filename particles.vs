@@ -0,0 +1,58 @@
+#version 330
+
+// Accretion disk particles animated entirely on the GPU
+// Attributes are uploaded once; orbit and Doppler factor are evaluated per frame here
+layout(location = 0) in vec4 particle;  // x: initial angle, y: radius, z: angular speed, w: height offset
+layout(location = 1) in uint epochStep; // Angle gained per epoch, in 2^-32 turns
+
+// Multi-view atlas, as in line.vs
+const int MAX_VIEWS = 4;
+uniform mat4 mvp[MAX_VIEWS];
+uniform int viewCount;
+uniform int epoch;             // Index of the current epoch, see GPU_TIME_EPOCH in main.cpp
+uniform float time;            // Seconds since it started
+uniform float diskInner;
+uniform float diskOuter;
+uniform float particleAlpha;
+uniform sampler2D diskLUT;     // GetDiskColor() tabulated over (t, D)
+uniform vec2 lutDopplerRange;
+
+out vec4 fragColor;
+
+const float TWO_PI = 6.28318530718;
+
+// Same addressing as sampleDiskLUT() in line.vs
+vec3 sampleDiskLUT(float t, float doppler) {
+    vec2 size = vec2(textureSize(diskLUT, 0));
+    vec2 uv = vec2(t, (doppler - lutDopplerRange.x) / (lutDopplerRange.y - lutDopplerRange.x));
+    uv = (clamp(uv, 0.0, 1.0) * (size - 1.0) + 0.5) / size;
+    return textureLod(diskLUT, uv, 0.0).rgb;
+}
+
+// Same as atlasPosition() in line.vs
+vec4 atlasPosition(vec4 clip) {
+    gl_ClipDistance[0] = clip.w + clip.x;
+    gl_ClipDistance[1] = clip.w - clip.x;
+    float n = float(max(viewCount, 1));
+    clip.x = (clip.x + clip.w * (1.0 + 2.0 * float(gl_InstanceID) - n)) / n;
+    return clip;
+}
+
+void main() {
+    // Keplerian motion: θ(t) = θ0 + ω·t, the whole epochs summed as a wrapping
+    // fraction of a turn so they stay exact
+    float epochTurns = float(uint(epoch) * epochStep) * (1.0 / 4294967296.0);
+    float angle = mod(particle.x + TWO_PI * epochTurns + particle.z * time, TWO_PI);
+    float r = particle.y;
+    float cosAngle = cos(angle);
+    vec3 pos = vec3(cosAngle * r, particle.w, sin(angle) * r);
+
+    // Relativistic Doppler factor, matches DopplerFactor() on the CPU path
+    float t = (r - diskInner) / (diskOuter - diskInner);
+    float beta = 0.4 / sqrt(r / diskInner);
+    float doppler = clamp(sqrt((1.0 + beta * cosAngle) / (1.0 - beta * cosAngle + 0.01)), 0.4, 1.8);
+
+    fragColor = vec4(sampleDiskLUT(t, doppler), particleAlpha);
+    gl_Position = atlasPosition(mvp[gl_InstanceID] * vec4(pos, 1.0));
+    gl_PointSize = 1.0;
+}
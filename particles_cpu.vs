@@ -0,0 +1,42 @@
+#version 330
+
+// CPU disk particles (particle_kernel.cpp): position and Doppler factor arrive
+// ready-made each frame; only the disk LUT fetch is left to the GPU
+layout(location = 0) in vec4 particle;  // xyz: position, w: Doppler factor
+
+// Multi-view atlas, as in line.vs
+const int MAX_VIEWS = 4;
+uniform mat4 mvp[MAX_VIEWS];
+uniform int viewCount;
+uniform float diskInner;
+uniform float diskOuter;
+uniform float particleAlpha;
+uniform sampler2D diskLUT;
+uniform vec2 lutDopplerRange;
+
+out vec4 fragColor;
+
+// Same addressing as sampleDiskLUT() in line.vs
+vec3 sampleDiskLUT(float t, float doppler) {
+    vec2 size = vec2(textureSize(diskLUT, 0));
+    vec2 uv = vec2(t, (doppler - lutDopplerRange.x) / (lutDopplerRange.y - lutDopplerRange.x));
+    uv = (clamp(uv, 0.0, 1.0) * (size - 1.0) + 0.5) / size;
+    return textureLod(diskLUT, uv, 0.0).rgb;
+}
+
+// Same as atlasPosition() in line.vs
+vec4 atlasPosition(vec4 clip) {
+    gl_ClipDistance[0] = clip.w + clip.x;
+    gl_ClipDistance[1] = clip.w - clip.x;
+    float n = float(max(viewCount, 1));
+    clip.x = (clip.x + clip.w * (1.0 + 2.0 * float(gl_InstanceID) - n)) / n;
+    return clip;
+}
+
+void main() {
+    // Orbits are circles in the disk plane, so the radius is the xz length
+    float t = (length(particle.xz) - diskInner) / (diskOuter - diskInner);
+
+    fragColor = vec4(sampleDiskLUT(t, particle.w), particleAlpha);
+    gl_Position = atlasPosition(mvp[gl_InstanceID] * vec4(particle.xyz, 1.0));
+}
@@ -0,0 +1,52 @@
+#version 330
+
+// Accretion disk particles drawn straight from the simulated state
+// (disk_sim.comp); the buffer the compute pass just wrote is the vertex buffer
+layout(location = 0) in vec4 particle;  // x: angle, y: radius, z: radial velocity, w: height
+
+// Multi-view atlas, as in line.vs
+const int MAX_VIEWS = 4;
+uniform mat4 mvp[MAX_VIEWS];
+uniform int viewCount;
+uniform float lead;            // Offset from the latest step in seconds: frames draw between steps
+uniform float diskInner;
+uniform float diskOuter;
+uniform float particleAlpha;
+uniform sampler2D diskLUT;     // GetDiskColor() tabulated over (t, D)
+uniform vec2 lutDopplerRange;
+
+out vec4 fragColor;
+
+// Same addressing as sampleDiskLUT() in line.vs
+vec3 sampleDiskLUT(float t, float doppler) {
+    vec2 size = vec2(textureSize(diskLUT, 0));
+    vec2 uv = vec2(t, (doppler - lutDopplerRange.x) / (lutDopplerRange.y - lutDopplerRange.x));
+    uv = (clamp(uv, 0.0, 1.0) * (size - 1.0) + 0.5) / size;
+    return textureLod(diskLUT, uv, 0.0).rgb;
+}
+
+// Same as atlasPosition() in line.vs
+vec4 atlasPosition(vec4 clip) {
+    gl_ClipDistance[0] = clip.w + clip.x;
+    gl_ClipDistance[1] = clip.w - clip.x;
+    float n = float(max(viewCount, 1));
+    clip.x = (clip.x + clip.w * (1.0 + 2.0 * float(gl_InstanceID) - n)) / n;
+    return clip;
+}
+
+void main() {
+    // Extrapolated along the orbit and the drift, as the CPU path's lead does
+    float r = max(particle.y + particle.z * lead, 1.0);
+    float angle = particle.x + 2.0 / sqrt(r) * lead;
+    float cosAngle = cos(angle);
+    vec3 pos = vec3(cosAngle * r, particle.w, sin(angle) * r);
+
+    // Same Doppler factor as particles.vs; plunging gas keeps the inner edge's colour
+    float t = max(r - diskInner, 0.0) / (diskOuter - diskInner);
+    float beta = 0.4 / sqrt(max(r, diskInner) / diskInner);
+    float doppler = clamp(sqrt((1.0 + beta * cosAngle) / (1.0 - beta * cosAngle + 0.01)), 0.4, 1.8);
+
+    fragColor = vec4(sampleDiskLUT(t, doppler), particleAlpha);
+    gl_Position = atlasPosition(mvp[gl_InstanceID] * vec4(pos, 1.0));
+    gl_PointSize = 1.0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// Philox4x32-10 counter-based random number generator (Salmon et al., "Parallel
+// random numbers: as easy as 1, 2, 3", SC 2011). Every output is a pure
+// function of (key, counter), so element i of an array can be generated on
+// any thread in any order and still come out identical for the same seed.
+// Scene generation keys it with the seed and uses {index, stream} as the counter.
+
+struct Philox4 {
+    uint32_t v[4];
+};
+
+inline Philox4 Philox4x32(uint64_t key, uint64_t index, uint32_t stream) {
+    const uint32_t M0 = 0xD2511F53u, M1 = 0xCD9E8D57u;
+    const uint32_t W0 = 0x9E3779B9u, W1 = 0xBB67AE85u;
+    uint32_t c0 = (uint32_t)index, c1 = (uint32_t)(index >> 32), c2 = stream, c3 = 0;
+    uint32_t k0 = (uint32_t)key, k1 = (uint32_t)(key >> 32);
+    for (int round = 0; round < 10; round++) {
+        uint64_t p0 = (uint64_t)M0 * c0, p1 = (uint64_t)M1 * c2;
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t)p1;
+        c3 = (uint32_t)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += W0;
+        k1 += W1;
+    }
+    return {{c0, c1, c2, c3}};
+}
+
+// Uniform in [0, 1) with the full 24-bit float mantissa
+inline float UnitFloat(uint32_t x) {
+    return (float)(x >> 8) * (1.0f / 16777216.0f);
+}
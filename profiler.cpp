@@ -0,0 +1,227 @@
+#include "profiler.h"
+
+#include <raylib.h>
+#include <rlgl.h>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+const char* PASS_NAMES[PASS_COUNT] = {
+    "input", "particle_update", "stars", "disk_lines", "particles",
+    "photon_lines", "disk_volume", "bloom", "lensing", "hud",
+};
+
+float MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Reads the queries issued PROFILER_LATENCY frames ago into their history entry.
+// If any result is still pending the whole frame is dropped instead of waiting,
+// unless `wait` is set.
+void CollectGpuTimes(Profiler& prof, int slot, bool wait) {
+    uint64_t frame = prof.slotFrame[slot];
+    bool any = false, ready = true;
+    for (int p = 0; p < PASS_COUNT; p++) {
+        if (!prof.issued[slot][p]) continue;
+        any = true;
+        gl::GLint available = 0;
+        gl::GetQueryObjectiv(prof.queries[slot][p], gl::QUERY_RESULT_AVAILABLE, &available);
+        ready = ready && (available || wait);
+    }
+    if (!any) return;
+
+    ProfileFrame& f = prof.history[frame % PROFILER_HISTORY];
+    if (ready && f.index == frame) {
+        for (int p = 0; p < PASS_COUNT; p++) {
+            if (!prof.issued[slot][p]) continue;
+            gl::GLuint64 ns = 0;
+            gl::GetQueryObjectui64v(prof.queries[slot][p], gl::QUERY_RESULT, &ns);
+            f.gpuMs[p] = ns * 1e-6f;
+        }
+        f.gpuValid = true;
+    } else if (!ready) {
+        prof.droppedGpuFrames++;
+    }
+    std::fill(prof.issued[slot], prof.issued[slot] + PASS_COUNT, false);
+}
+
+ProfileStats ComputeStats(std::vector<float>& samples) {
+    ProfileStats s;
+    s.samples = (int)samples.size();
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    float sum = 0.0f;
+    for (float v : samples) sum += v;
+    s.min = samples.front();
+    s.avg = sum / samples.size();
+    s.p99 = samples[std::min(samples.size() - 1, (size_t)(samples.size() * 0.99f))];
+    return s;
+}
+
+// Visits the completed frames of the overlay window, newest first
+template <typename F>
+void ForEachWindowFrame(const Profiler& prof, F&& fn) {
+    for (int i = 1; i <= PROFILER_WINDOW && (uint64_t)i <= prof.frame; i++) {
+        const ProfileFrame& f = prof.history[(prof.frame - i) % PROFILER_HISTORY];
+        if (f.complete && f.index == prof.frame - i) fn(f);
+    }
+}
+
+} // namespace
+
+Profiler LoadProfiler() {
+    Profiler prof;
+    prof.history.resize(PROFILER_HISTORY);
+    gl::GenQueries(PROFILER_LATENCY * PASS_COUNT, &prof.queries[0][0]);
+    prof.frameStart = std::chrono::steady_clock::now();
+    return prof;
+}
+
+void UnloadProfiler(Profiler& prof) {
+    gl::DeleteQueries(PROFILER_LATENCY * PASS_COUNT, &prof.queries[0][0]);
+    prof.history.clear();
+}
+
+void BeginProfileFrame(Profiler& prof) {
+    int slot = prof.frame % PROFILER_LATENCY;
+    CollectGpuTimes(prof, slot, false);
+    prof.slotFrame[slot] = prof.frame;
+
+    ProfileFrame& f = prof.history[prof.frame % PROFILER_HISTORY];
+    f = {};
+    f.index = prof.frame;
+    prof.frameStart = std::chrono::steady_clock::now();
+}
+
+void FinishProfiler(Profiler& prof) {
+    // Oldest slot first; QUERY_RESULT blocks until each one lands
+    for (int i = 0; i < PROFILER_LATENCY; i++)
+        CollectGpuTimes(prof, (prof.frame + i) % PROFILER_LATENCY, true);
+}
+
+void EndProfileFrame(Profiler& prof) {
+    // Frame time is closed by the swap, so measure it here after EndDrawing
+    ProfileFrame& f = prof.history[prof.frame % PROFILER_HISTORY];
+    f.frameMs = MillisecondsSince(prof.frameStart);
+    f.complete = true;
+    prof.frame++;
+}
+
+void BeginProfilePass(Profiler& prof, ProfilePass pass) {
+    rlDrawRenderBatchActive();
+    int slot = prof.frame % PROFILER_LATENCY;
+    gl::BeginQuery(gl::TIME_ELAPSED, prof.queries[slot][pass]);
+    prof.issued[slot][pass] = true;
+    prof.activePass = pass;
+    prof.passStart = std::chrono::steady_clock::now();
+}
+
+void EndProfilePass(Profiler& prof) {
+    if (prof.activePass < 0) return;
+    rlDrawRenderBatchActive();
+    gl::EndQuery(gl::TIME_ELAPSED);
+    prof.history[prof.frame % PROFILER_HISTORY].cpuMs[prof.activePass] = MillisecondsSince(prof.passStart);
+    prof.activePass = -1;
+}
+
+const char* GetProfilePassName(ProfilePass pass) {
+    return PASS_NAMES[pass];
+}
+
+ProfileStats GetProfileStats(const Profiler& prof, ProfilePass pass, bool gpu) {
+    std::vector<float> samples;
+    samples.reserve(PROFILER_WINDOW);
+    ForEachWindowFrame(prof, [&](const ProfileFrame& f) {
+        if (!gpu) samples.push_back(f.cpuMs[pass]);
+        else if (f.gpuValid) samples.push_back(f.gpuMs[pass]);
+    });
+    return ComputeStats(samples);
+}
+
+ProfileStats GetFrameTimeStats(const Profiler& prof) {
+    std::vector<float> samples;
+    samples.reserve(PROFILER_WINDOW);
+    ForEachWindowFrame(prof, [&](const ProfileFrame& f) { samples.push_back(f.frameMs); });
+    return ComputeStats(samples);
+}
+
+bool GetLatestWorkTimes(const Profiler& prof, float& cpuMs, float& gpuMs) {
+    bool cpu = false, gpu = false;
+    for (int i = 1; i <= 2 * PROFILER_LATENCY && (uint64_t)i <= prof.frame && !(cpu && gpu); i++) {
+        const ProfileFrame& f = prof.history[(prof.frame - i) % PROFILER_HISTORY];
+        if (f.index != prof.frame - i) continue;
+        if (!cpu && f.complete) {
+            cpuMs = 0.0f;
+            for (float ms : f.cpuMs) cpuMs += ms;
+            cpu = true;
+        }
+        if (!gpu && f.gpuValid) {
+            gpuMs = 0.0f;
+            for (float ms : f.gpuMs) gpuMs += ms;
+            gpu = true;
+        }
+    }
+    return cpu && gpu;
+}
+
+void DrawProfilerOverlay(const Profiler& prof, int x, int y) {
+    const int ROW = 16;
+    const int FONT = 14;
+    DrawRectangle(x, y, 470, ROW * (PASS_COUNT + 3) + 8, Fade(BLACK, 0.7f));
+    x += 6;
+    y += 4;
+
+    DrawText("pass", x, y, FONT, LIGHTGRAY);
+    DrawText("CPU min/avg/p99 ms", x + 130, y, FONT, LIGHTGRAY);
+    DrawText("GPU min/avg/p99 ms", x + 300, y, FONT, LIGHTGRAY);
+    y += ROW;
+
+    for (int p = 0; p < PASS_COUNT; p++) {
+        ProfileStats cpu = GetProfileStats(prof, (ProfilePass)p, false);
+        ProfileStats gpu = GetProfileStats(prof, (ProfilePass)p, true);
+        DrawText(PASS_NAMES[p], x, y, FONT, WHITE);
+        DrawText(TextFormat("%5.2f %5.2f %5.2f", cpu.min, cpu.avg, cpu.p99), x + 130, y, FONT, WHITE);
+        DrawText(gpu.samples ? TextFormat("%5.2f %5.2f %5.2f", gpu.min, gpu.avg, gpu.p99) : "  --", x + 300, y, FONT, WHITE);
+        y += ROW;
+    }
+
+    ProfileStats frame = GetFrameTimeStats(prof);
+    DrawText(TextFormat("frame %5.2f %5.2f %5.2f", frame.min, frame.avg, frame.p99), x, y, FONT, YELLOW);
+    y += ROW;
+    DrawText(TextFormat("%d frames, %llu GPU readbacks dropped  [F2] Dump CSV", frame.samples,
+                        (unsigned long long)prof.droppedGpuFrames), x, y, FONT, GRAY);
+}
+
+bool DumpProfilerCSV(const Profiler& prof, const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        TraceLog(LOG_WARNING, "PROFILER: Failed to open %s", path);
+        return false;
+    }
+
+    fprintf(file, "frame,frame_ms");
+    for (int p = 0; p < PASS_COUNT; p++) fprintf(file, ",%s_cpu_ms", PASS_NAMES[p]);
+    for (int p = 0; p < PASS_COUNT; p++) fprintf(file, ",%s_gpu_ms", PASS_NAMES[p]);
+    fprintf(file, "\n");
+
+    int rows = 0;
+    uint64_t first = prof.frame > PROFILER_HISTORY ? prof.frame - PROFILER_HISTORY : 0;
+    for (uint64_t i = first; i < prof.frame; i++) {
+        const ProfileFrame& f = prof.history[i % PROFILER_HISTORY];
+        if (!f.complete || f.index != i) continue;
+        fprintf(file, "%llu,%.4f", (unsigned long long)f.index, f.frameMs);
+        for (int p = 0; p < PASS_COUNT; p++) fprintf(file, ",%.4f", f.cpuMs[p]);
+        // GPU columns stay empty for the last few frames whose queries are in flight
+        for (int p = 0; p < PASS_COUNT; p++) {
+            if (f.gpuValid) fprintf(file, ",%.4f", f.gpuMs[p]);
+            else fprintf(file, ",");
+        }
+        fprintf(file, "\n");
+        rows++;
+    }
+
+    fclose(file);
+    TraceLog(LOG_INFO, "PROFILER: Wrote %d frames to %s", rows, path);
+    return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "gl_ext.h"
+
+// Per-pass frame profiler. CPU time is wall clock around each pass; GPU time
+// comes from GL_TIME_ELAPSED queries that are read back PROFILER_LATENCY
+// frames later, and only if the driver already has the result, so the
+// profiler never waits on the GPU.
+
+enum ProfilePass {
+    PASS_INPUT,            // Input, camera and render scale
+    PASS_PARTICLE_UPDATE,  // CPU disk orbits
+    PASS_STARS,            // Pass 1: starfield or skybox
+    PASS_DISK_LINES,       // Pass 1: disk rings and Einstein ring
+    PASS_PARTICLES,        // Pass 1: GPU or CPU disk particles
+    PASS_PHOTON_LINES,     // Pass 1: photon sphere and inner glow
+    PASS_DISK_VOLUME,      // Ray-marched disk [V] (and its upsample)
+    PASS_BLOOM,            // Bloom chain
+    PASS_LENSING,          // Pass 2: lensing shader (and TAA resolve, upscale)
+    PASS_HUD,              // Text, overlay
+    PASS_COUNT
+};
+
+const int PROFILER_LATENCY = 4;      // Frames between issuing a query and reading it
+const int PROFILER_HISTORY = 512;    // Frames kept for the CSV dump
+const int PROFILER_WINDOW = 240;     // Frames the overlay statistics cover
+
+struct ProfileFrame {
+    uint64_t index = 0;
+    bool complete = false;           // CPU times recorded
+    bool gpuValid = false;           // GPU times read back
+    float frameMs = 0.0f;            // Frame start to next frame start
+    float cpuMs[PASS_COUNT] = {};
+    float gpuMs[PASS_COUNT] = {};
+};
+
+struct Profiler {
+    std::vector<ProfileFrame> history;
+    uint64_t frame = 0;
+    gl::GLuint queries[PROFILER_LATENCY][PASS_COUNT] = {};
+    bool issued[PROFILER_LATENCY][PASS_COUNT] = {};
+    uint64_t slotFrame[PROFILER_LATENCY] = {};
+    int activePass = -1;
+    uint64_t droppedGpuFrames = 0;
+    std::chrono::steady_clock::time_point frameStart, passStart;
+};
+
+Profiler LoadProfiler();
+void UnloadProfiler(Profiler& prof);
+
+// Frame boundaries: BeginProfileFrame collects finished GPU timings
+void BeginProfileFrame(Profiler& prof);
+void EndProfileFrame(Profiler& prof);
+
+// Blocks until every in-flight query has landed in the history. Only meant
+// for the end of a run, where a stall no longer matters.
+void FinishProfiler(Profiler& prof);
+
+// Passes must not nest and each runs at most once a frame. Both calls flush
+// the raylib batch so batched draws are submitted (and timed) in the pass
+// that queued them.
+void BeginProfilePass(Profiler& prof, ProfilePass pass);
+void EndProfilePass(Profiler& prof);
+
+const char* GetProfilePassName(ProfilePass pass);
+
+// Rolling statistics over the last PROFILER_WINDOW frames
+struct ProfileStats {
+    float min = 0.0f, avg = 0.0f, p99 = 0.0f;
+    int samples = 0;
+};
+ProfileStats GetProfileStats(const Profiler& prof, ProfilePass pass, bool gpu);
+ProfileStats GetFrameTimeStats(const Profiler& prof);
+
+// Summed pass times of the newest frames that have them: CPU work (which
+// leaves out the swap and any frame limiter wait) and GPU work, which lags a
+// few frames. False until both exist.
+bool GetLatestWorkTimes(const Profiler& prof, float& cpuMs, float& gpuMs);
+
+void DrawProfilerOverlay(const Profiler& prof, int x, int y);
+
+// Writes every recorded frame in the history, oldest first
+bool DumpProfilerCSV(const Profiler& prof, const char* path);
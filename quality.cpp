@@ -0,0 +1,92 @@
+#include "quality.h"
+
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Lensing stage sets, shed in this order
+const unsigned STAGES_ALL = LENS_STAGES_ALL;
+const unsigned STAGES_NO_CHROMATIC = STAGES_ALL & ~LENS_CHROMATIC;
+const unsigned STAGES_NO_GRADING = STAGES_NO_CHROMATIC & ~LENS_CONTRAST;
+const unsigned STAGES_NO_FXAA = STAGES_NO_GRADING & ~LENS_FXAA;
+const unsigned STAGES_MIN = STAGES_NO_FXAA & ~LENS_BLOOM;
+
+const float SMOOTHING = 0.1f;        // Per-frame weight of the newest times
+const float SETTLE_TIME = 0.5f;      // Seconds after a step before it is judged
+const float OVER_BUDGET = 1.05f;     // Step down above this share of the budget
+const float HEADROOM = 0.7f;         // Step up below it, once raiseDelay has passed
+const float RAISE_DELAY_MIN = 2.0f;
+const float RAISE_DELAY_MAX = 30.0f;
+
+void Step(QualityGovernor& g, int level, float costMs) {
+    int from = g.level;
+    g.level = level;
+    g.raised = level < from;
+    g.sinceChange = 0.0f;
+    const char* change = g.raised ? QUALITY_LEVELS[from].change : QUALITY_LEVELS[level].change;
+    TraceLog(LOG_INFO, "QUALITY: %.2f ms (CPU %.2f, GPU %.2f) vs %.2f ms budget: level %d -> %d, %s%s", costMs,
+             g.avgCpuMs, g.avgGpuMs, g.budgetMs, from, level, g.raised ? "undoing " : "", change);
+}
+
+} // namespace
+
+const QualityLevel QUALITY_LEVELS[] = {
+    // change                      scale  parts  bloom  lod  msaa   lens stages
+    {"full quality",               1.00f, 1.00f, 4, 1.0f, true,  STAGES_ALL},
+    {"coarser ring LOD",           1.00f, 1.00f, 4, 2.0f, true,  STAGES_ALL},
+    {"scene MSAA off",             1.00f, 1.00f, 4, 2.0f, false, STAGES_ALL},
+    {"chromatic aberration off",   1.00f, 1.00f, 4, 2.0f, false, STAGES_NO_CHROMATIC},
+    {"75% disk particles",         1.00f, 0.75f, 4, 2.0f, false, STAGES_NO_CHROMATIC},
+    {"3 bloom levels",             1.00f, 0.75f, 3, 2.0f, false, STAGES_NO_CHROMATIC},
+    {"90% render scale",           0.90f, 0.75f, 3, 2.0f, false, STAGES_NO_CHROMATIC},
+    {"50% disk particles",         0.90f, 0.50f, 3, 2.0f, false, STAGES_NO_CHROMATIC},
+    {"80% render scale",           0.80f, 0.50f, 3, 2.0f, false, STAGES_NO_CHROMATIC},
+    {"2 bloom levels",             0.80f, 0.50f, 2, 2.0f, false, STAGES_NO_CHROMATIC},
+    {"contrast boost off",         0.80f, 0.50f, 2, 2.0f, false, STAGES_NO_GRADING},
+    {"70% render scale",           0.70f, 0.50f, 2, 2.0f, false, STAGES_NO_GRADING},
+    {"coarsest ring LOD",          0.70f, 0.50f, 2, 4.0f, false, STAGES_NO_GRADING},
+    {"30% disk particles",         0.70f, 0.30f, 2, 4.0f, false, STAGES_NO_GRADING},
+    {"60% render scale",           0.60f, 0.30f, 2, 4.0f, false, STAGES_NO_GRADING},
+    {"FXAA off",                   0.60f, 0.30f, 2, 4.0f, false, STAGES_NO_FXAA},
+    {"50% render scale",           0.50f, 0.30f, 2, 4.0f, false, STAGES_NO_FXAA},
+    {"bloom off",                  0.50f, 0.30f, 2, 4.0f, false, STAGES_MIN},
+};
+const int QUALITY_LEVEL_COUNT = sizeof(QUALITY_LEVELS) / sizeof(QUALITY_LEVELS[0]);
+
+void UpdateQualityGovernor(QualityGovernor& g, const Profiler& prof, float dt) {
+    float cpuMs, gpuMs;
+    if (!g.enabled || !GetLatestWorkTimes(prof, cpuMs, gpuMs)) return;
+    g.avgCpuMs += (cpuMs - g.avgCpuMs) * SMOOTHING;
+    g.avgGpuMs += (gpuMs - g.avgGpuMs) * SMOOTHING;
+    g.sinceChange += dt;
+    if (g.sinceChange < SETTLE_TIME) return;
+
+    // CPU and GPU overlap, so the slower of the two sets the frame time
+    float cost = std::max(g.avgCpuMs, g.avgGpuMs);
+    if (cost > g.budgetMs * OVER_BUDGET && g.level < QUALITY_LEVEL_COUNT - 1) {
+        // Undoing a raise straight away: wait longer before the next one
+        if (g.raised) g.raiseDelay = std::min(g.raiseDelay * 2.0f, RAISE_DELAY_MAX);
+        Step(g, g.level + 1, cost);
+    } else if (cost < g.budgetMs * HEADROOM && g.level > 0 && g.sinceChange > g.raiseDelay) {
+        Step(g, g.level - 1, cost);
+    } else if (g.raised && g.sinceChange > g.raiseDelay) {
+        // The last raise held
+        g.raised = false;
+        g.raiseDelay = RAISE_DELAY_MIN;
+    }
+}
+
+const QualityLevel& GetQualityLevel(const QualityGovernor& g) {
+    return QUALITY_LEVELS[g.enabled ? g.level : 0];
+}
+
+void ResetQualityGovernor(QualityGovernor& g) {
+    bool enabled = g.enabled;
+    float budget = g.budgetMs;
+    g = {};
+    g.enabled = enabled;
+    g.budgetMs = budget;
+    TraceLog(LOG_INFO, "QUALITY: Governor %s, %.2f ms budget", enabled ? "on" : "off", budget);
+}
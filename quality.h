@@ -0,0 +1,45 @@
+#pragma once
+
+#include "lens_shader.h"
+#include "profiler.h"
+
+// Adaptive quality governor. Watches the measured CPU and GPU work of each
+// frame (profiler pass times, so vsync or a frame limiter can't hide
+// headroom) and steps through QUALITY_LEVELS to hold a frame-time budget.
+// Levels run from full quality down; each one lowers a single knob of the one
+// above it, cheapest visual loss first and render scale mostly last, so the
+// table is the priority list. Every step is logged with the times behind it.
+
+struct QualityLevel {
+    const char* change;              // What this level lowers, for the log
+    float renderScale;
+    float particleFraction;          // Share of the disk particles updated and drawn
+    int bloomLevels;                 // Bloom chain depth; fewer is cheaper and tighter
+    float lodErrorScale;             // Multiplies the ring tessellation error bound
+    bool msaa;                       // Float scene MSAA (still off under TAA)
+    unsigned lensStages;             // LensStage bits the lensing programs keep
+};
+
+extern const QualityLevel QUALITY_LEVELS[];
+extern const int QUALITY_LEVEL_COUNT;
+
+const float QUALITY_BUDGET_DEFAULT_MS = 1000.0f / 60.0f;
+
+struct QualityGovernor {
+    bool enabled = false;            // Off: level 0 stays, render scale is manual
+    float budgetMs = QUALITY_BUDGET_DEFAULT_MS;
+    int level = 0;
+    float avgCpuMs = 0.0f, avgGpuMs = 0.0f;
+    float sinceChange = 0.0f;
+    float raiseDelay = 2.0f;         // Seconds of headroom before stepping back up
+    bool raised = false;             // Last step was up
+};
+
+// Once per frame with the frame's duration
+void UpdateQualityGovernor(QualityGovernor& g, const Profiler& prof, float dt);
+
+// Level 0 when the governor is off
+const QualityLevel& GetQualityLevel(const QualityGovernor& g);
+
+// Starts over at full quality (the governor being switched on)
+void ResetQualityGovernor(QualityGovernor& g);
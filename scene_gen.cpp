@@ -0,0 +1,42 @@
+#include "scene_gen.h"
+
+#include <cmath>
+
+#include <raylib.h>
+
+#include "philox.h"
+
+std::vector<Star> CreateStars(JobSystem& jobs, int n, uint64_t seed) {
+    std::vector<Star> stars(n);
+    JobGroup group;
+    ParallelFor(jobs, group, n, SCENE_GEN_GRAIN, [&stars, seed](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            Philox4 r = Philox4x32(seed, i, RNG_STREAM_STARS);
+            float theta = UnitFloat(r.v[0]) * 2.0f * PI;
+            float phi = UnitFloat(r.v[1]) * PI;
+            float d = 50.0f + UnitFloat(r.v[2]) * 50.0f;
+            stars[i] = {d * sinf(phi) * cosf(theta), d * cosf(phi),
+                        d * sinf(phi) * sinf(theta), 0.5f + UnitFloat(r.v[3]) * 0.5f};
+        }
+    });
+    WaitJobGroup(jobs, group);
+    return stars;
+}
+
+std::vector<Particle> CreateDisk(JobSystem& jobs, int n, float rIn, float rOut, uint64_t seed, uint32_t stream) {
+    std::vector<Particle> p(n);
+    JobGroup group;
+    ParallelFor(jobs, group, n, SCENE_GEN_GRAIN, [&p, rIn, rOut, seed, stream](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            Philox4 r = Philox4x32(seed, i, stream);
+            float t = UnitFloat(r.v[0]);
+            t = t * t; // Quadratic bias toward inner edge
+            p[i].radius = rIn + t * (rOut - rIn);
+            p[i].angle = UnitFloat(r.v[1]) * 2.0f * PI;
+            p[i].speed = 2.0f / sqrtf(p[i].radius); // Keplerian: v ∝ r^(-1/2)
+            p[i].yOffset = (UnitFloat(r.v[2]) * 2.0f - 1.0f) * 0.05f;
+        }
+    });
+    WaitJobGroup(jobs, group);
+    return p;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "job_system.h"
+#include "particle_kernel.h"
+
+// Scene generation: element i of every array comes from Philox keyed by the
+// seed with counter {i, stream}, so the arrays are filled in parallel chunks
+// and still come out identical for a given --seed
+const uint64_t SCENE_SEED_DEFAULT = 0x6A7267;
+const uint32_t RNG_STREAM_STARS = 1;
+const uint32_t RNG_STREAM_CPU_DISK = 2;
+const uint32_t RNG_STREAM_GPU_DISK = 3;
+const int SCENE_GEN_GRAIN = 65536;
+
+struct Star { float x, y, z, brightness; };
+
+// Distributes stars uniformly on a sphere using spherical coordinates
+// theta: azimuthal angle [0, 2π], phi: polar angle [0, π]
+std::vector<Star> CreateStars(JobSystem& jobs, int n, uint64_t seed);
+
+// Particle distribution weighted toward inner disk edge (t² bias)
+// Models higher density near ISCO where matter accumulates before plunging
+std::vector<Particle> CreateDisk(JobSystem& jobs, int n, float rIn, float rOut, uint64_t seed, uint32_t stream);
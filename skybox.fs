@@ -0,0 +1,10 @@
+#version 330
+
+in vec3 viewDir;
+out vec4 finalColor;
+
+uniform samplerCube skybox;
+
+void main() {
+    finalColor = vec4(texture(skybox, normalize(viewDir)).rgb, 1.0);
+}
@@ -0,0 +1,20 @@
+#version 330
+
+// Full-screen triangle generated from gl_VertexID (no vertex buffer)
+// Each corner is unprojected to a world-space view direction for the cubemap lookup
+// In multi-view, instance i covers atlas column i, as in line.vs
+const int MAX_VIEWS = 4;
+uniform mat4 invViewProj[MAX_VIEWS];  // inverse of rotation-only view * projection
+uniform int viewCount;
+
+out vec3 viewDir;
+
+void main() {
+    vec2 ndc = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+    vec4 world = invViewProj[gl_InstanceID] * vec4(ndc, 1.0, 1.0);
+    viewDir = world.xyz / world.w;
+    gl_ClipDistance[0] = 1.0 + ndc.x;
+    gl_ClipDistance[1] = 1.0 - ndc.x;
+    float n = float(max(viewCount, 1));
+    gl_Position = vec4((ndc.x + 1.0 + 2.0 * float(gl_InstanceID) - n) / n, ndc.y, 1.0, 1.0);
+}
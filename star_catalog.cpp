@@ -0,0 +1,105 @@
+#include "star_catalog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <raylib.h>
+
+namespace {
+
+// Catalogue CSV columns, in order
+struct CsvStar {
+    float ra, dec, mag, bv;
+};
+
+int16_t ToMilliMag(float m) {
+    return (int16_t)std::clamp(lroundf(m * STAR_MAG_SCALE), -32768L, 32767L);
+}
+
+} // namespace
+
+bool OpenStarCatalog(StarCatalog& cat, const std::string& path) {
+    cat = {};
+    if (!MapFile(cat.file, path)) {
+        TraceLog(LOG_ERROR, "STARS: Failed to map %s", path.c_str());
+        return false;
+    }
+
+    const StarCatalogHeader* h = (const StarCatalogHeader*)cat.file.view;
+    const char* problem = nullptr;
+    if (cat.file.size < sizeof(StarCatalogHeader) || memcmp(h->magic, STAR_CATALOG_MAGIC, 4) != 0) problem = "not a star catalogue";
+    else if (h->version != STAR_CATALOG_VERSION) problem = "unsupported version";
+    else if (h->recordSize != sizeof(StarRecord)) problem = "unexpected record size";
+    else if (cat.file.size < sizeof(StarCatalogHeader) + (size_t)h->count * sizeof(StarRecord)) problem = "truncated";
+    if (problem) {
+        TraceLog(LOG_ERROR, "STARS: %s: %s", path.c_str(), problem);
+        CloseStarCatalog(cat);
+        return false;
+    }
+
+    cat.header = h;
+    cat.records = (const StarRecord*)(h + 1);
+    cat.count = (int)h->count;
+    TraceLog(LOG_INFO, "STARS: Mapped %s: %d stars, magnitude %.2f to %.2f", path.c_str(), cat.count, h->magMin, h->magMax);
+    return true;
+}
+
+void CloseStarCatalog(StarCatalog& cat) {
+    UnmapFile(cat.file);
+    cat = {};
+}
+
+int CountStarsBrighterThan(const StarCatalog& cat, float magLimit) {
+    int16_t limit = ToMilliMag(magLimit);
+    const StarRecord* end = std::upper_bound(cat.records, cat.records + cat.count, limit,
+                                             [](int16_t m, const StarRecord& r) { return m < r.magnitude; });
+    return (int)(end - cat.records);
+}
+
+bool ConvertStarCatalog(const std::string& csvPath, const std::string& outPath) {
+    FILE* in = fopen(csvPath.c_str(), "r");
+    if (!in) {
+        TraceLog(LOG_ERROR, "STARS: Failed to open %s", csvPath.c_str());
+        return false;
+    }
+    std::vector<CsvStar> stars;
+    char line[512];
+    int skipped = 0;
+    while (fgets(line, sizeof(line), in)) {
+        CsvStar s;
+        if (sscanf(line, " %f , %f , %f , %f", &s.ra, &s.dec, &s.mag, &s.bv) == 4) stars.push_back(s);
+        else skipped++;
+    }
+    fclose(in);
+
+    std::stable_sort(stars.begin(), stars.end(), [](const CsvStar& a, const CsvStar& b) { return a.mag < b.mag; });
+
+    std::vector<StarRecord> records(stars.size());
+    for (size_t i = 0; i < stars.size(); i++) {
+        float ra = stars[i].ra * DEG2RAD, dec = stars[i].dec * DEG2RAD;
+        records[i] = {{cosf(dec) * cosf(ra), sinf(dec), cosf(dec) * sinf(ra)}, ToMilliMag(stars[i].mag),
+                      ToMilliMag(stars[i].bv)};
+    }
+
+    StarCatalogHeader h = {};
+    memcpy(h.magic, STAR_CATALOG_MAGIC, 4);
+    h.version = STAR_CATALOG_VERSION;
+    h.count = (uint32_t)records.size();
+    h.recordSize = sizeof(StarRecord);
+    h.magMin = stars.empty() ? 0.0f : stars.front().mag;
+    h.magMax = stars.empty() ? 0.0f : stars.back().mag;
+
+    FILE* out = fopen(outPath.c_str(), "wb");
+    bool ok = out && fwrite(&h, sizeof(h), 1, out) == 1 &&
+              fwrite(records.data(), sizeof(StarRecord), records.size(), out) == records.size();
+    if (out && fclose(out) != 0) ok = false;
+    if (!ok) {
+        TraceLog(LOG_ERROR, "STARS: Failed to write %s", outPath.c_str());
+        return false;
+    }
+    TraceLog(LOG_INFO, "STARS: Wrote %d stars to %s (%d lines skipped)", (int)records.size(), outPath.c_str(), skipped);
+    return true;
+}
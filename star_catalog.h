@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "mapped_file.h"
+
+// Binary star catalogue, memory-mapped and uploaded to the GPU as is.
+//
+// File layout (little endian): a 32-byte StarCatalogHeader followed by `count`
+// 16-byte StarRecords sorted by magnitude, brightest first. Every star down to
+// a magnitude limit is therefore a prefix of the file: CountStarsBrighterThan
+// finds its length, and only those pages are ever touched or uploaded.
+// ConvertStarCatalog builds the file from a CSV export (Hipparcos, Gaia, ...).
+
+struct StarCatalogOptions {
+    std::string path;                // Catalogue to render instead of the random star field
+    std::string convertFrom;         // CSV to convert into `path`, then exit
+    float magLimit = 9.0f;           // Faintest magnitude drawn at full quality
+};
+
+const char STAR_CATALOG_MAGIC[4] = {'B', 'H', 'S', 'C'};
+const uint32_t STAR_CATALOG_VERSION = 1;
+const float STAR_MAG_SCALE = 1000.0f;  // Magnitudes and colour indices are stored in millimag
+
+struct StarCatalogHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t recordSize;             // sizeof(StarRecord)
+    float magMin, magMax;            // Brightest and faintest entry
+    uint32_t reserved[2];
+};
+
+// Maps to two vertex attributes: vec3 direction and (magnitude, B-V) as shorts
+struct StarRecord {
+    float dir[3];                    // Unit vector, +Y towards the celestial north pole
+    int16_t magnitude;               // Apparent visual magnitude × STAR_MAG_SCALE
+    int16_t colorIndex;              // B-V colour index × STAR_MAG_SCALE
+};
+
+static_assert(sizeof(StarCatalogHeader) == 32, "Catalogue header layout is part of the file format");
+static_assert(sizeof(StarRecord) == 16, "Catalogue record layout is part of the file format");
+
+struct StarCatalog {
+    const StarCatalogHeader* header = nullptr;
+    const StarRecord* records = nullptr;
+    int count = 0;
+
+    MappedFile file;
+};
+
+// Maps the file and validates the header; false (with a log line) if unusable
+bool OpenStarCatalog(StarCatalog& cat, const std::string& path);
+void CloseStarCatalog(StarCatalog& cat);
+
+// Length of the prefix holding every star at magLimit or brighter
+int CountStarsBrighterThan(const StarCatalog& cat, float magLimit);
+
+// Reads "ra_deg,dec_deg,vmag,bv" lines (others are skipped as headers or
+// comments), sorts them by magnitude and writes the binary catalogue
+bool ConvertStarCatalog(const std::string& csvPath, const std::string& outPath);
@@ -0,0 +1,13 @@
+#version 330
+
+in vec4 fragColor;
+out vec4 finalColor;
+
+void main() {
+    // Round point sprite with a soft edge; 1px points sample the center only
+    vec2 c = gl_PointCoord * 2.0 - 1.0;
+    float r2 = dot(c, c);
+    if (r2 > 1.0) discard;
+
+    finalColor = vec4(fragColor.rgb * (1.0 - r2 * r2), 1.0);
+}
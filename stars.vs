@@ -0,0 +1,27 @@
+#version 330
+
+// Static starfield, uploaded once as a single point buffer
+layout(location = 0) in vec4 star;  // xyz: world position, w: brightness
+
+// Multi-view atlas, as in line.vs
+const int MAX_VIEWS = 4;
+uniform mat4 mvp[MAX_VIEWS];
+uniform int viewCount;
+uniform float pointSize;
+
+out vec4 fragColor;
+
+// Same as atlasPosition() in line.vs
+vec4 atlasPosition(vec4 clip) {
+    gl_ClipDistance[0] = clip.w + clip.x;
+    gl_ClipDistance[1] = clip.w - clip.x;
+    float n = float(max(viewCount, 1));
+    clip.x = (clip.x + clip.w * (1.0 + 2.0 * float(gl_InstanceID) - n)) / n;
+    return clip;
+}
+
+void main() {
+    fragColor = vec4(vec3(star.w), 1.0);
+    gl_Position = atlasPosition(mvp[gl_InstanceID] * vec4(star.xyz, 1.0));
+    gl_PointSize = pointSize;
+}
@@ -0,0 +1,47 @@
+#version 330
+
+// Catalogue stars (star_catalog.h), drawn straight from the mapped records
+layout(location = 0) in vec3 starDir;   // Unit direction
+layout(location = 1) in vec2 starMag;   // Visual magnitude, B-V colour index (millimag)
+
+// Multi-view atlas, as in line.vs
+const int MAX_VIEWS = 4;
+uniform mat4 mvp[MAX_VIEWS];
+uniform int viewCount;
+uniform float pointSize;
+uniform float magLimit;     // Faintest magnitude in the drawn prefix
+uniform float starDistance;
+
+out vec4 fragColor;
+
+// B-V to a display tint: blue-white O/B stars through white to orange-red M stars
+vec3 starTint(float bv) {
+    vec3 c = mix(vec3(0.62, 0.72, 1.0), vec3(0.85, 0.9, 1.0), smoothstep(-0.4, 0.0, bv));
+    c = mix(c, vec3(1.0, 1.0, 0.93), smoothstep(0.0, 0.6, bv));
+    c = mix(c, vec3(1.0, 0.85, 0.7), smoothstep(0.6, 1.0, bv));
+    return mix(c, vec3(1.0, 0.65, 0.4), smoothstep(1.0, 1.6, bv));
+}
+
+// Same as atlasPosition() in line.vs
+vec4 atlasPosition(vec4 clip) {
+    gl_ClipDistance[0] = clip.w + clip.x;
+    gl_ClipDistance[1] = clip.w - clip.x;
+    float n = float(max(viewCount, 1));
+    clip.x = (clip.x + clip.w * (1.0 + 2.0 * float(gl_InstanceID) - n)) / n;
+    return clip;
+}
+
+void main() {
+    float mag = starMag.x / 1000.0;
+    float bv = starMag.y / 1000.0;
+
+    // Magnitudes are logarithmic already: spread them linearly over the display
+    // range, and fade the last half magnitude so raising the limit doesn't pop
+    float brightness = 0.3 + 0.7 * clamp((magLimit - mag) / max(magLimit, 1.0), 0.0, 1.0);
+    brightness *= 1.0 - smoothstep(magLimit - 0.5, magLimit, mag);
+
+    fragColor = vec4(starTint(bv) * brightness, 1.0);
+    gl_Position = atlasPosition(mvp[gl_InstanceID] * vec4(starDir * starDistance, 1.0));
+    // The few stars brighter than magnitude 2 get a larger sprite
+    gl_PointSize = pointSize * (1.0 + clamp((2.0 - mag) / 3.5, 0.0, 1.0));
+}
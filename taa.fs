@@ -0,0 +1,89 @@
+#version 330
+
+// Temporal anti-aliasing resolve [T], drawn at the output resolution
+// The lensed frame was rendered with a sub-pixel jittered projection; this pass
+// removes the jitter, reprojects the previous resolve with the camera motion
+// and blends the two after clipping the history to the current neighbourhood.
+// When the render scale is below 1 the history keeps the output's detail, so
+// the resolve doubles as a temporal upscaler.
+//
+// There is no velocity buffer: each pixel's world point is rebuilt from the
+// layout of the scene, which is all the orbital camera needs. That is, in
+// order, the disk plane, the hole's neighbourhood (the lensed image moves with
+// the hole) and the sky at infinity.
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform sampler2D texture0;    // Current lensed frame, render resolution, jittered
+uniform sampler2D history;     // Previous resolve, output resolution
+uniform vec2 sourceTexel;      // 1 / render resolution
+uniform vec2 jitter;           // This frame's projection offset in source pixels
+uniform mat4 invViewProj;      // Current frame, unjittered
+uniform mat4 prevViewProj;     // Previous frame, unjittered
+uniform vec3 cameraPos;
+uniform float diskOuter;       // Radius holding every disk, around the origin
+uniform float historyValid;    // 0 on the first frame and after a reset
+
+const float BLEND = 0.1;       // Weight of the current frame in a converged pixel
+const float CLIP_GAMMA = 1.0;  // Variance clip box size in standard deviations
+
+vec3 toYCoCg(vec3 c) {
+    return vec3(dot(c, vec3(0.25, 0.5, 0.25)), dot(c, vec3(0.5, 0.0, -0.5)), dot(c, vec3(-0.25, 0.5, -0.25)));
+}
+
+vec3 fromYCoCg(vec3 c) {
+    return vec3(c.x + c.y - c.z, c.x + c.z, c.x - c.y - c.z);
+}
+
+// Screen position of this pixel's world point in the previous frame
+vec2 reproject(vec2 uv) {
+    vec4 far = invViewProj * vec4(uv * 2.0 - 1.0, 1.0, 1.0);
+    vec3 dir = normalize(far.xyz / far.w - cameraPos);
+
+    vec4 prev;
+    float tDisk = abs(dir.y) > 1e-4 ? -cameraPos.y / dir.y : -1.0;
+    float tNear = -dot(cameraPos, dir);
+    if (tDisk > 0.0 && length((cameraPos + dir * tDisk).xz) < diskOuter) {
+        prev = prevViewProj * vec4(cameraPos + dir * tDisk, 1.0);
+    } else if (tNear > 0.0 && length(cameraPos + dir * tNear) < diskOuter) {
+        prev = prevViewProj * vec4(cameraPos + dir * tNear, 1.0);
+    } else {
+        prev = prevViewProj * vec4(dir, 0.0);  // Direction only: the sky doesn't parallax
+    }
+    return prev.w > 0.0 ? prev.xy / prev.w * 0.5 + 0.5 : vec2(-1.0);
+}
+
+void main() {
+    vec2 uv = fragTexCoord;
+    vec2 src = uv - jitter * sourceTexel;
+    vec3 current = texture(texture0, src).rgb;
+
+    // Mean and deviation of the 3x3 source neighbourhood
+    vec3 m1 = vec3(0.0), m2 = vec3(0.0);
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            vec3 c = toYCoCg(texture(texture0, src + vec2(x, y) * sourceTexel).rgb);
+            m1 += c;
+            m2 += c * c;
+        }
+    }
+    m1 /= 9.0;
+    vec3 sigma = sqrt(max(m2 / 9.0 - m1 * m1, 0.0)) * CLIP_GAMMA;
+
+    vec2 prevUV = reproject(uv);
+    bool onScreen = all(greaterThanEqual(prevUV, vec2(0.0))) && all(lessThanEqual(prevUV, vec2(1.0)));
+    if (historyValid == 0.0 || !onScreen) {
+        finalColor = vec4(current, 1.0);
+        return;
+    }
+
+    // Clip the history towards the box centre rather than clamping per channel,
+    // which keeps its hue when it falls outside
+    vec3 hist = toYCoCg(texture(history, prevUV).rgb);
+    vec3 offset = hist - m1;
+    vec3 ratio = abs(offset) / max(sigma, vec3(1e-4));
+    float excess = max(ratio.x, max(ratio.y, ratio.z));
+    if (excess > 1.0) hist = m1 + offset / excess;
+
+    finalColor = vec4(mix(fromYCoCg(hist), current, BLEND), 1.0);
+}
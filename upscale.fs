@@ -0,0 +1,27 @@
+#version 330
+
+// Upscales the reduced-resolution lensed frame to the backbuffer
+// Bilinear fetch plus an optional unsharp mask at source-texel spacing to
+// restore some of the edge contrast lost to resampling
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform vec2 sourceTexel;   // 1 / internal render resolution
+uniform float sharpness;    // 0: plain bilinear, ~0.5: moderate sharpening
+
+void main() {
+    vec3 c = texture(texture0, fragTexCoord).rgb;
+    if (sharpness > 0.0) {
+        vec3 n = texture(texture0, fragTexCoord + vec2(0.0, -sourceTexel.y)).rgb;
+        vec3 s = texture(texture0, fragTexCoord + vec2(0.0, sourceTexel.y)).rgb;
+        vec3 e = texture(texture0, fragTexCoord + vec2(sourceTexel.x, 0.0)).rgb;
+        vec3 w = texture(texture0, fragTexCoord + vec2(-sourceTexel.x, 0.0)).rgb;
+        vec3 blur = (n + s + e + w) * 0.25;
+        // Clamp to the local range so sharpening can't ring past its neighbours
+        vec3 lo = min(c, min(min(n, s), min(e, w)));
+        vec3 hi = max(c, max(max(n, s), max(e, w)));
+        c = clamp(c + (c - blur) * sharpness, lo, hi);
+    }
+    finalColor = vec4(c, 1.0);
+}